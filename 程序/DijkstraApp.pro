@@ -26,8 +26,25 @@ SOURCES += \
     datamanagementwindow.cpp \
     databasemanagementwindow.cpp \
     dijkstra.cpp \
+    dijkstra_csr.cpp \
+    dijkstra_alt.cpp \
+    dijkstra_ch.cpp \
+    dijkstra_cch.cpp \
+    dijkstra_hub.cpp \
+    dijkstra_arcflags.cpp \
+    dijkstra_delta.cpp \
+    dijkstra_matrix.cpp \
+    dijkstra_apsp.cpp \
+    dijkstra_floyd.cpp \
+    dijkstra_dense.cpp \
+    dijkstra_bfs.cpp \
+    dijkstra_lanes.cpp \
+    dijkstra_treecache.cpp \
+    dijkstra_idmap.cpp \
+    dijkstra_order.cpp \
     dijkstra_loader.cpp \
-    graphdatabase.cpp
+    graphdatabase.cpp \
+    graphsnapshot.cpp
 
 HEADERS += \
     mainwindow.h \
@@ -35,8 +52,29 @@ HEADERS += \
     datamanagementwindow.h \
     databasemanagementwindow.h \
     dijkstra.h \
+    dijkstra_heap.h \
+    dijkstra_csr.h \
+    dijkstra_alt.h \
+    dijkstra_ch.h \
+    dijkstra_cch.h \
+    dijkstra_hub.h \
+    dijkstra_arcflags.h \
+    dijkstra_delta.h \
+    dijkstra_matrix.h \
+    dijkstra_apsp.h \
+    dijkstra_floyd.h \
+    dijkstra_dense.h \
+    dijkstra_bfs.h \
+    dijkstra_lanes.h \
+    dijkstra_treecache.h \
+    dijkstra_workspace.h \
+    dijkstra_basic.h \
+    dijkstra_idmap.h \
+    dijkstra_order.h \
+    dijkstra_simd.h \
     dijkstra_loader.h \
-    graphdatabase.h
+    graphdatabase.h \
+    graphsnapshot.h
 
 FORMS += \
     mainwindow.ui
@@ -0,0 +1,1126 @@
+#include "dijkstra.h"
+#include "dijkstra_lanes.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QTextStream>
+#include <QFileInfo>
+#include <QDir>
+#include <QFile>
+#include <QThread>
+#include <QtConcurrent>
+#include <QStringList>
+
+// 基准测试：比较不同引擎/数据结构在同一数据集上的查询耗时
+// 每一轮使用相同的随机起点/终点序列，并校验各方案得到的距离一致
+
+static QTextStream out(stdout);
+static int mismatchCount = 0;       // 结果不一致的测试项数，非零时 main 返回失败
+
+// 比较结果的标注；不一致时计数，便于脚本通过退出码发现回归
+static QString verdict(bool same)
+{
+    if (!same)
+        mismatchCount++;
+    return same ? "结果一致" : "结果不一致!";
+}
+
+// 随机生成查询用的节点ID对（固定种子，保证可重复）
+static QVector<QPair<long, long>> makeQueries(const Dijkstra &dijkstra, int count)
+{
+    QVector<long> ids = dijkstra.getAllNodeIDs();
+    QRandomGenerator rng(20240601);
+    QVector<QPair<long, long>> queries;
+    for (int i = 0; i < count; i++)
+    {
+        long s = ids[rng.bounded(int(ids.size()))];
+        long t = ids[rng.bounded(int(ids.size()))];
+        queries.append(qMakePair(s, t));
+    }
+    return queries;
+}
+
+// 依次执行所有查询，返回总耗时（毫秒），距离结果写入 results，
+// settled 非空时累计各查询确定的节点数
+static double runQueries(Dijkstra &dijkstra, const QVector<QPair<long, long>> &queries,
+                         QVector<long> &results, qint64 *settled = nullptr)
+{
+    results.clear();
+    if (settled)
+        *settled = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (const auto &q : queries)
+    {
+        long distance = 0;
+        QVector<long> path;
+        int ret = dijkstra.getDistance(q.first, q.second, distance, path);
+        results.append(ret > 0 ? distance : -1);
+        if (settled)
+            *settled += dijkstra.settledNodeCount();
+    }
+    return timer.nsecsElapsed() / 1e6;
+}
+
+static void benchmarkQueues(Dijkstra &dijkstra, const QVector<QPair<long, long>> &queries)
+{
+    struct QueueCase { Dijkstra::QueueType type; const char *name; };
+    const QueueCase cases[] = {
+        { Dijkstra::QueueLinearScan,     "线性扫描 (原实现)" },
+        { Dijkstra::QueueDaryHeap,       "4叉索引堆" },
+        { Dijkstra::QueueLazyBinaryHeap, "惰性删除二叉堆" },
+        { Dijkstra::QueueDialBuckets,    "Dial 桶队列" },
+        { Dijkstra::QueueRadixHeap,      "基数堆" },
+        { Dijkstra::QueueDenseMatrix,    "稠密矩阵 (SIMD)" },
+        { Dijkstra::QueueBfs,            "BFS 队列" },
+        { Dijkstra::QueueAuto,           "自动选择" },
+    };
+
+    out << "\n== 优先队列对比 ==\n";
+    QVector<long> reference;
+    double baseTime = 0;
+    for (const QueueCase &c : cases)
+    {
+        dijkstra.setQueueType(c.type);
+        QVector<long> results;
+        double ms = runQueries(dijkstra, queries, results);
+        if (reference.isEmpty())
+        {
+            reference = results;
+            baseTime = ms;
+        }
+        out << QString("%1  %2 ms  加速比 %3x  %4\n")
+                   .arg(QString(c.name), -20)
+                   .arg(ms, 10, 'f', 2)
+                   .arg(ms > 0 ? baseTime / ms : 0.0, 0, 'f', 2)
+                   .arg(verdict(results == reference));
+        out.flush();
+    }
+
+    dijkstra.setQueueType(Dijkstra::QueueAuto);
+    Dijkstra::QueueType chosen = dijkstra.effectiveQueueType();
+    out << QString("自动选择结果: %1\n")
+               .arg(chosen == Dijkstra::QueueBfs ? "BFS 队列"
+                    : chosen == Dijkstra::QueueDenseMatrix ? "稠密矩阵"
+                    : chosen == Dijkstra::QueueDialBuckets ? "Dial 桶队列"
+                    : chosen == Dijkstra::QueueRadixHeap ? "基数堆" : "4叉索引堆");
+}
+
+// 多对多：sourceCount 个起点到全部节点，比较逐行 Dijkstra 与 8 路 SIMD 批量搜索（单线程与全部核心）
+static void benchmarkLaneBatch(Dijkstra &dijkstra, int sourceCount)
+{
+    out << QString("\n== SIMD 批量搜索 (%1 行 × 全部节点, %2) ==\n")
+               .arg(sourceCount)
+               .arg(SimdCpu::levelName(SimdCpu::detect()));
+
+    if (!LaneBatchSearch::suitable(dijkstra.csrGraph()))
+    {
+        out << "存在负边权或距离超出 32 位，跳过\n";
+        return;
+    }
+
+    QVector<long> ids = dijkstra.getAllNodeIDs();
+    QRandomGenerator rng(20240625);
+    QVector<long> sources;
+    for (int i = 0; i < sourceCount; i++)
+        sources.append(ids[rng.bounded(ids.size())]);
+
+    QVector<int> threadCounts = { 1 };
+    if (QThread::idealThreadCount() > 1)
+        threadCounts.append(QThread::idealThreadCount());
+    for (int threads : threadCounts)
+    {
+        QVector<long> reference, distances;
+        QElapsedTimer timer;
+        timer.start();
+        dijkstra.setDistanceMatrixMethod(DistanceMatrix::MethodDijkstra);
+        dijkstra.distanceMatrix(sources, ids, reference, QVector<QPair<int, int>>(), nullptr, threads);
+        double dijkstraMs = timer.nsecsElapsed() / 1e6;
+
+        timer.restart();
+        dijkstra.setDistanceMatrixMethod(DistanceMatrix::MethodLanes);
+        dijkstra.distanceMatrix(sources, ids, distances, QVector<QPair<int, int>>(), nullptr, threads);
+        double lanesMs = timer.nsecsElapsed() / 1e6;
+
+        out << QString("%1 线程  Dijkstra %2 ms  批量 %3 ms  加速比 %4x  %5\n")
+                   .arg(threads)
+                   .arg(dijkstraMs, 10, 'f', 2)
+                   .arg(lanesMs, 10, 'f', 2)
+                   .arg(lanesMs > 0 ? dijkstraMs / lanesMs : 0.0, 0, 'f', 2)
+                   .arg(verdict(distances == reference));
+        out.flush();
+    }
+    dijkstra.setDistanceMatrixMethod(DistanceMatrix::MethodAuto);
+}
+
+// 全部边权相同的图：比较每 64 个起点一批的位并行 BFS 与逐个起点 Dijkstra 计算 sourceCount 行完整距离（单线程）
+static void benchmarkMultiSourceBfs(Dijkstra &dijkstra, int sourceCount)
+{
+    out << "\n== 位并行多源 BFS (单位权图) ==\n";
+
+    const CsrGraph &csr = dijkstra.csrGraph();
+    if (csr.uniformWeight() == 0)
+    {
+        out << "边权不全相同，跳过\n";
+        return;
+    }
+
+    QVector<long> ids = dijkstra.getAllNodeIDs();
+    QRandomGenerator rng(20240620);
+    QVector<long> sources;
+    for (int i = 0; i < sourceCount; i++)
+        sources.append(ids[rng.bounded(ids.size())]);
+
+    QVector<long> reference;
+    QVector<long> distance;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < sources.size(); i++)
+    {
+        csr.shortestPaths(dijkstra.nodeIndex(sources[i]), distance);
+        for (int v = 1; v < distance.size(); v++)
+            reference.append(distance[v]);
+    }
+    double dijkstraMs = timer.nsecsElapsed() / 1e6;
+
+    QVector<long> distances;
+    timer.restart();
+    dijkstra.distanceMatrix(sources, ids, distances, QVector<QPair<int, int>>(), nullptr, 1);
+    double bfsMs = timer.nsecsElapsed() / 1e6;
+
+    out << QString("%1 行 × %2 列  边权 %3\n").arg(sources.size()).arg(ids.size()).arg(csr.uniformWeight());
+    out << QString("%1  %2 ms\n").arg(QString("逐个起点 Dijkstra"), -20).arg(dijkstraMs, 10, 'f', 2);
+    out << QString("%1  %2 ms  加速比 %3x  %4\n")
+               .arg(QString("位并行 BFS"), -20)
+               .arg(bfsMs, 10, 'f', 2)
+               .arg(bfsMs > 0 ? dijkstraMs / bfsMs : 0.0, 0, 'f', 2)
+               .arg(verdict(distances == reference));
+    out.flush();
+}
+
+// 不同密度的随机图上比较稠密矩阵搜索与自动选择的堆，用于确定自动切换的密度阈值
+static void benchmarkDenseGraphs(int nodeCount, int queryCount)
+{
+    out << QString("\n== 稠密图矩阵搜索 (随机图 %1 个节点, %2) ==\n")
+               .arg(nodeCount)
+               .arg(SimdCpu::levelName(SimdCpu::detect()));
+
+    const double densities[] = { 0.02, 0.05, 0.1, 0.25, 0.5, 1.0 };
+    for (double density : densities)
+    {
+        Dijkstra graph;
+        QRandomGenerator rng(20240615);
+        for (int u = 1; u <= nodeCount; u++)
+        {
+            for (int v = u + 1; v <= nodeCount; v++)
+            {
+                if (rng.generateDouble() < density)
+                    graph.addNodesDist(u, v, 1 + rng.bounded(5000));
+            }
+        }
+        QVector<QPair<long, long>> queries = makeQueries(graph, queryCount);
+
+        // 阈值设为 0 时自动选择只在堆之间进行
+        graph.setDenseThreshold(0);
+        QVector<long> reference;
+        double heapMs = runQueries(graph, queries, reference);
+        graph.setQueueType(Dijkstra::QueueDenseMatrix);
+        QVector<long> results;
+        double denseMs = runQueries(graph, queries, results);
+
+        out << QString("密度 %1  堆 %2 ms  矩阵 %3 ms  加速比 %4x  %5\n")
+                   .arg(graph.getGraphStats().density, 5, 'f', 3)
+                   .arg(heapMs, 10, 'f', 2)
+                   .arg(denseMs, 10, 'f', 2)
+                   .arg(denseMs > 0 ? heapMs / denseMs : 0.0, 0, 'f', 2)
+                   .arg(verdict(results == reference));
+        out.flush();
+    }
+}
+
+static void benchmarkEarlyTermination(Dijkstra &dijkstra, const QVector<QPair<long, long>> &queries)
+{
+    out << "\n== 点对点提前终止 ==\n";
+    QVector<long> fullResults, p2pResults;
+
+    dijkstra.setEarlyTermination(false);
+    double fullMs = runQueries(dijkstra, queries, fullResults);
+    dijkstra.setEarlyTermination(true);
+    double p2pMs = runQueries(dijkstra, queries, p2pResults);
+
+    out << QString("完整搜索  %1 ms\n").arg(fullMs, 10, 'f', 2);
+    out << QString("提前终止  %1 ms  加速比 %2x  %3\n")
+               .arg(p2pMs, 10, 'f', 2)
+               .arg(p2pMs > 0 ? fullMs / p2pMs : 0.0, 0, 'f', 2)
+               .arg(verdict(p2pResults == fullResults));
+    out.flush();
+}
+
+// 最短路径树缓存：查询起点在少数几个节点间轮换时，回到已搜索过的起点直接回溯缓存的树
+static void benchmarkTreeCache(Dijkstra &dijkstra, const QVector<QPair<long, long>> &randomQueries,
+                               int sourceCount, int queryCount)
+{
+    out << "\n== 最短路径树缓存 ==\n";
+    QVector<long> ids = dijkstra.getAllNodeIDs();
+    QRandomGenerator rng(20240617);
+    QVector<long> sources;
+    for (int i = 0; i < sourceCount; i++)
+        sources.append(ids[rng.bounded(int(ids.size()))]);
+    QVector<QPair<long, long>> queries;
+    for (int i = 0; i < queryCount; i++)
+        queries.append(qMakePair(sources[i % sourceCount], ids[rng.bounded(int(ids.size()))]));
+
+    QVector<long> plainResults, cachedResults;
+    dijkstra.setTreeCacheBudget(0);
+    double plainMs = runQueries(dijkstra, queries, plainResults);
+
+    dijkstra.setTreeCacheBudget(ShortestPathTreeCache::DEFAULT_BUDGET);
+    dijkstra.treeCache().clear();
+    dijkstra.treeCache().resetCounters();
+    double cachedMs = runQueries(dijkstra, queries, cachedResults);
+    const ShortestPathTreeCache &cache = dijkstra.treeCache();
+
+    out << QString("%1 个起点轮换  %2 次查询\n").arg(sourceCount).arg(queryCount);
+    out << QString("不缓存    %1 ms\n").arg(plainMs, 10, 'f', 2);
+    out << QString("缓存      %1 ms  加速比 %2x  %3\n")
+               .arg(cachedMs, 10, 'f', 2)
+               .arg(cachedMs > 0 ? plainMs / cachedMs : 0.0, 0, 'f', 2)
+               .arg(verdict(cachedResults == plainResults));
+    out << QString("命中 %1  未命中 %2  缓存 %3 棵树  %4 KB\n")
+               .arg(cache.hitCount()).arg(cache.missCount())
+               .arg(cache.size()).arg(cache.memoryUsage() / 1024);
+
+    // 默认配置（缓存开启、提前终止）下起点几乎不重复：每次换起点都把上一次的搜索存入缓存，
+    // 提前终止的搜索只存已确定的节点，存入的开销应与搜索范围成正比，不随图的规模增长
+    dijkstra.setTreeCacheBudget(0);
+    QVector<long> offResults, defaultResults;
+    double offMs = runQueries(dijkstra, randomQueries, offResults);
+    dijkstra.setTreeCacheBudget(ShortestPathTreeCache::DEFAULT_BUDGET);
+    dijkstra.treeCache().clear();
+    double defaultMs = runQueries(dijkstra, randomQueries, defaultResults);
+    out << QString("随机起点 %1 次查询（默认配置）\n").arg(randomQueries.size());
+    out << QString("不缓存    %1 ms\n").arg(offMs, 10, 'f', 2);
+    out << QString("缓存      %1 ms  开销 %2%  缓存 %3 棵树  %4 KB  %5\n")
+               .arg(defaultMs, 10, 'f', 2)
+               .arg(offMs > 0 ? (defaultMs - offMs) * 100 / offMs : 0.0, 0, 'f', 1)
+               .arg(cache.size()).arg(cache.memoryUsage() / 1024)
+               .arg(verdict(defaultResults == offResults));
+
+    // 其他测试比较的是搜索本身，不使用缓存
+    dijkstra.setTreeCacheBudget(0);
+    out.flush();
+}
+
+// 并发只读查询：多个线程用各自的工作区同时查询同一张图
+static void benchmarkConcurrentQueries(Dijkstra &dijkstra, const QVector<QPair<long, long>> &queries)
+{
+    out << "\n== 并发只读查询 ==\n";
+    QVector<long> serialResults;
+    dijkstra.setEarlyTermination(true);
+    double serialMs = runQueries(dijkstra, queries, serialResults);
+
+    QVector<long> results(queries.size());
+    QVector<int> indices;
+    for (int i = 0; i < queries.size(); i++)
+        indices.append(i);
+    QElapsedTimer timer;
+    timer.start();
+    QtConcurrent::blockingMap(indices, [&dijkstra, &queries, &results](int i) {
+        long distance = 0;
+        QVector<long> path;
+        int ret = dijkstra.query(queries[i].first, queries[i].second, distance, path);
+        results[i] = ret > 0 ? distance : -1;
+    });
+    double parallelMs = timer.nsecsElapsed() / 1e6;
+
+    out << QString("getDistance 单线程  %1 ms\n").arg(serialMs, 10, 'f', 2);
+    out << QString("query %1 线程       %2 ms  加速比 %3x  %4\n")
+               .arg(QThread::idealThreadCount())
+               .arg(parallelMs, 10, 'f', 2)
+               .arg(parallelMs > 0 ? serialMs / parallelMs : 0.0, 0, 'f', 2)
+               .arg(verdict(results == serialResults));
+    out.flush();
+}
+
+// BasicDijkstra 的各组合：getDistance（等长前驱列表）、带空动画回调、query（单个前驱）、queryDistance（只算距离），
+// 以及边权可用 32 位表示时的 <int, int, false, false>
+static void benchmarkPolicySearch(Dijkstra &dijkstra, const QVector<QPair<long, long>> &queries)
+{
+    out << "\n== 搜索组合（BasicDijkstra 模板参数）==\n";
+    dijkstra.setEarlyTermination(true);
+    QVector<long> reference;
+    double treeMs = runQueries(dijkstra, queries, reference);
+
+    auto timeQueries = [&queries](const std::function<long(long, long)> &distanceOf, QVector<long> &results) {
+        results.clear();
+        QElapsedTimer timer;
+        timer.start();
+        for (const auto &q : queries)
+            results.append(distanceOf(q.first, q.second));
+        return timer.nsecsElapsed() / 1e6;
+    };
+    auto report = [&reference, treeMs](const QString &name, double ms, const QVector<long> &results) {
+        out << QString("%1 %2 ms  相对 getDistance %3x  %4\n")
+                   .arg(name, -34)
+                   .arg(ms, 10, 'f', 2)
+                   .arg(ms > 0 ? treeMs / ms : 0.0, 0, 'f', 2)
+                   .arg(verdict(results == reference));
+    };
+    out << QString("%1 %2 ms\n").arg("getDistance <long, int, true, true>", -34).arg(treeMs, 10, 'f', 2);
+
+    QVector<long> results;
+    AnimationCallback noop = [](int, long, bool) {};
+    double ms = timeQueries([&dijkstra, &noop](long s, long t) {
+        long distance = 0;
+        QVector<long> path;
+        return dijkstra.getDistance(s, t, distance, path, noop) > 0 ? distance : -1;
+    }, results);
+    report("getDistance + 空动画回调", ms, results);
+
+    QueryWorkspace workspace;
+    ms = timeQueries([&dijkstra, &workspace](long s, long t) {
+        long distance = 0;
+        QVector<long> path;
+        return dijkstra.query(s, t, distance, path, &workspace) > 0 ? distance : -1;
+    }, results);
+    report("query <long, int, true, false>", ms, results);
+
+    ms = timeQueries([&dijkstra, &workspace](long s, long t) {
+        long distance = 0;
+        return dijkstra.queryDistance(s, t, distance, &workspace) > 0 ? distance : -1;
+    }, results);
+    report("queryDistance <long, int, false, false>", ms, results);
+
+    // 32 位边权：最长路径不超过 CsrGraph::UNREACHABLE 时才能使用
+    const CsrGraph &csr = dijkstra.csrGraph();
+    if (csr.minWeight < 0 || qint64(csr.maxWeight) * csr.nodeCount() >= CsrGraph::UNREACHABLE)
+    {
+        out << "边权范围过大，跳过 32 位边权组合\n";
+        out.flush();
+        return;
+    }
+    QVector<int> weights32(csr.weights.size());
+    for (int e = 0; e < csr.weights.size(); e++)
+        weights32[e] = int(csr.weights[e]);
+    CsrView<int, int> view32;
+    view32.nodeCount = csr.nodeCount();
+    view32.offsets = csr.offsets.constData();
+    view32.targets = csr.targets.constData();
+    view32.weights = weights32.constData();
+    CompactSearchWorkspace<int, int, false> state32;
+    // 与 getDistance 自动选择的单调整数队列相同
+    DialQueue dial;
+    RadixHeap radix;
+    bool useDial = csr.maxWeight <= Dijkstra::DIAL_MAX_WEIGHT;
+    dial.setMaxWeight(csr.maxWeight);
+    ms = timeQueries([&dijkstra, &view32, &state32, &dial, &radix, useDial](long s, long t) {
+        int iStart = dijkstra.nodeIndex(s);
+        int iEnd = dijkstra.nodeIndex(t);
+        state32.resize(view32.nodeCount);
+        state32.reset();
+        BasicDijkstra<int, int, false, false> search(view32, state32);
+        if (useDial)
+        {
+            search.start(dial, iStart);
+            search.run(dial, iEnd);
+        }
+        else
+        {
+            search.start(radix, iStart);
+            search.run(radix, iEnd);
+        }
+        return state32.visited(iEnd) ? long(state32.distance(iEnd)) : -1L;
+    }, results);
+    report("BasicDijkstra <int, int, false, false>", ms, results);
+    out.flush();
+}
+
+// 节点 ID 映射：原来的 QMap 与 NodeIdMap 的插入和查找耗时，ID 分别取数据文件的 ID、连续编号 1..N 和打散后的稀疏 ID
+static void benchmarkIdLookup(const Dijkstra &dijkstra, int rounds)
+{
+    out << "\n== 节点 ID 映射 ==\n";
+    QVector<long> ids = dijkstra.getAllNodeIDs();
+    QVector<long> denseIds(ids.size());
+    QVector<long> sparseIds(ids.size());
+    for (int i = 0; i < ids.size(); i++)
+    {
+        denseIds[i] = i + 1;
+        sparseIds[i] = long(quint32(ids[i]) * 2654435761u);
+    }
+
+    // 按固定步长打乱查找顺序，避免顺序访问掩盖缓存未命中
+    QVector<int> order(ids.size());
+    for (int i = 0; i < ids.size(); i++)
+        order[i] = int((qint64(i) * 7919) % ids.size());
+
+    auto report = [&ids, rounds](const QString &name, double insertMs, double lookupMs, qint64 checksum) {
+        out << QString("%1 插入 %2 ms  查找 %3 ns/次  校验 %4\n")
+                   .arg(name, -24)
+                   .arg(insertMs, 8, 'f', 2)
+                   .arg(ids.isEmpty() ? 0.0 : lookupMs * 1e6 / (double(ids.size()) * rounds), 6, 'f', 1)
+                   .arg(checksum);
+    };
+
+    QElapsedTimer timer;
+    const QVector<long> *keySets[] = { &ids, &denseIds, &sparseIds };
+    const char *suffixes[] = { "（文件 ID）", "（连续 ID）", "（稀疏 ID）" };
+    for (int pass = 0; pass < 3; pass++)
+    {
+        const QVector<long> &keys = *keySets[pass];
+        QString suffix = suffixes[pass];
+
+        timer.start();
+        QMap<long, int> map;
+        for (int i = 0; i < keys.size(); i++)
+            map.insert(keys[i], i + 1);
+        double insertMs = timer.nsecsElapsed() / 1e6;
+        qint64 checksum = 0;
+        timer.restart();
+        for (int r = 0; r < rounds; r++)
+            for (int i : order)
+                checksum += map.value(keys[i]);
+        report("QMap" + suffix, insertMs, timer.nsecsElapsed() / 1e6, checksum);
+
+        timer.restart();
+        NodeIdMap idMap;
+        for (int i = 0; i < keys.size(); i++)
+            idMap.insert(keys[i], i + 1);
+        idMap.compact();
+        insertMs = timer.nsecsElapsed() / 1e6;
+        checksum = 0;
+        timer.restart();
+        for (int r = 0; r < rounds; r++)
+            for (int i : order)
+                checksum += idMap.value(keys[i]);
+        report(QString("NodeIdMap %1%2").arg(idMap.isDirect() ? "直接数组" : "散列表").arg(suffix),
+               insertMs, timer.nsecsElapsed() / 1e6, checksum);
+    }
+    out.flush();
+}
+
+// 冻结时的节点重排：同一组查询在原顺序与各重排顺序下的耗时（getDistance 与只算距离的 queryDistance）和平均边跨度
+// 数据文件没有坐标，Hilbert 只在合成的网格图上比较；网格图的节点按打乱的顺序加入，模拟编号与位置无关的数据
+static void benchmarkNodeOrder(const QString &fileName, const QVector<QPair<long, long>> &queries, int gridSide)
+{
+    out << "\n== 节点重排 ==\n";
+
+    QMap<long, QPointF> gridCoordinates;
+    QVector<QPair<QPair<long, long>, long>> gridEdges;
+    {
+        int count = gridSide * gridSide;
+        QVector<long> ids(count);
+        for (int i = 0; i < count; i++)
+            ids[i] = i + 1;
+        QRandomGenerator rng(20240620);
+        for (int i = count - 1; i > 0; i--)
+            std::swap(ids[i], ids[rng.bounded(i + 1)]);
+        for (int i = 0; i < count; i++)
+        {
+            int x = i % gridSide;
+            int y = i / gridSide;
+            gridCoordinates.insert(ids[i], QPointF(x, y));
+            if (x + 1 < gridSide)
+                gridEdges.append(qMakePair(qMakePair(ids[i], ids[i + 1]), long(1 + rng.bounded(100))));
+            if (y + 1 < gridSide)
+                gridEdges.append(qMakePair(qMakePair(ids[i], ids[i + gridSide]), long(1 + rng.bounded(100))));
+        }
+        // 边也按随机顺序加入，节点索引按首次出现的顺序分配
+        for (int i = gridEdges.size() - 1; i > 0; i--)
+            std::swap(gridEdges[i], gridEdges[rng.bounded(i + 1)]);
+    }
+
+    const NodeOrdering::Method methods[] = {
+        NodeOrdering::None, NodeOrdering::Bfs, NodeOrdering::ReverseCuthillMcKee, NodeOrdering::Hilbert
+    };
+    for (int pass = 0; pass < 2; pass++)
+    {
+        bool grid = (pass == 1);
+        if (grid)
+            out << QString("网格图 %1 × %1\n").arg(gridSide);
+        else
+            out << QString("数据文件 %1\n").arg(QFileInfo(fileName).fileName());
+
+        QVector<QPair<long, long>> gridQueries;
+        QVector<long> reference;
+        double baseMs = 0;
+        for (NodeOrdering::Method method : methods)
+        {
+            if (method == NodeOrdering::Hilbert && !grid)
+                continue;
+
+            Dijkstra graph;
+            graph.setTreeCacheBudget(0);
+            graph.setNodeOrder(method);
+            QElapsedTimer timer;
+            timer.start();
+            if (grid)
+            {
+                for (const auto &edge : gridEdges)
+                    graph.addNodesDist(edge.first.first, edge.first.second, edge.second);
+                graph.setNodeCoordinates(gridCoordinates);
+                graph.freeze();
+            }
+            else if (!graph.loadFileData(fileName))
+            {
+                out << "加载失败: " << graph.errorDescription() << "\n";
+                return;
+            }
+            double loadMs = timer.nsecsElapsed() / 1e6;
+            if (grid && gridQueries.isEmpty())
+                gridQueries = makeQueries(graph, queries.size());
+            const QVector<QPair<long, long>> &current = grid ? gridQueries : queries;
+
+            QVector<long> results;
+            double ms = runQueries(graph, current, results);
+            QVector<long> distances;
+            timer.restart();
+            for (const auto &q : current)
+            {
+                long distance = 0;
+                distances.append(graph.queryDistance(q.first, q.second, distance) > 0 ? distance : -1);
+            }
+            double distanceMs = timer.nsecsElapsed() / 1e6;
+            if (method == NodeOrdering::None)
+            {
+                reference = results;
+                baseMs = ms;
+            }
+
+            out << QString("%1 载入 %2 ms  边跨度 %3  getDistance %4 ms  加速比 %5x  queryDistance %6 ms  %7\n")
+                       .arg(NodeOrdering::name(method), -8)
+                       .arg(loadMs, 8, 'f', 2)
+                       .arg(NodeOrdering::averageEdgeSpan(graph.csrGraph()), 8, 'f', 1)
+                       .arg(ms, 10, 'f', 2)
+                       .arg(ms > 0 ? baseMs / ms : 0.0, 0, 'f', 2)
+                       .arg(distanceMs, 10, 'f', 2)
+                       .arg(verdict(results == reference && distances == reference));
+            out.flush();
+        }
+    }
+}
+
+static void benchmarkEngines(Dijkstra &dijkstra, const QVector<QPair<long, long>> &queries)
+{
+    struct EngineCase { Dijkstra::QueryEngine engine; const char *name; };
+    const EngineCase cases[] = {
+        { Dijkstra::EngineDijkstra,      "单向 Dijkstra" },
+        { Dijkstra::EngineBidirectional, "双向 Dijkstra" },
+        { Dijkstra::EngineALT,           "ALT (A* + 地标)" },
+        { Dijkstra::EngineCH,            "收缩层次 (CH)" },
+        { Dijkstra::EngineCCH,           "可定制收缩层次 (CCH)" },
+        { Dijkstra::EngineHubLabels,     "中心点标签 (PLL)" },
+        { Dijkstra::EngineArcFlags,      "弧标志 (Arc Flags)" },
+        { Dijkstra::EngineDeltaStepping, "并行 delta-stepping" },
+    };
+
+    out << "\n== 查询引擎对比 ==\n";
+
+    // 预处理耗时与内存
+    QElapsedTimer timer;
+    timer.start();
+    dijkstra.buildLandmarks(16);
+    out << QString("ALT 预处理: 16 个地标  %1 ms  %2 KB\n")
+               .arg(timer.elapsed())
+               .arg(dijkstra.landmarkMemoryUsage() / 1024);
+    timer.restart();
+    dijkstra.buildContractionHierarchy();
+    const ContractionHierarchy &ch = dijkstra.contractionHierarchy();
+    out << QString("CH 预处理: %1 条捷径  %2 ms  %3 KB\n")
+               .arg(ch.shortcutCount())
+               .arg(timer.elapsed())
+               .arg(ch.memoryUsage() / 1024);
+    timer.restart();
+    dijkstra.buildCustomizableCH();
+    const CustomizableCH &cch = dijkstra.customizableCH();
+    out << QString("CCH 预处理: 向上图 %1 条边  消除树高度 %2  %3 ms  %4 KB\n")
+               .arg(cch.arcCount())
+               .arg(cch.treeHeight())
+               .arg(timer.elapsed())
+               .arg(cch.memoryUsage() / 1024);
+    timer.restart();
+    dijkstra.buildHubLabels();
+    const HubLabels &hub = dijkstra.hubLabels();
+    out << QString("中心点标签: 平均 %1 项  最大 %2 项  %3 ms  %4 KB\n")
+               .arg(hub.averageLabelSize(), 0, 'f', 1)
+               .arg(hub.maxLabelSize())
+               .arg(timer.elapsed())
+               .arg(hub.memoryUsage() / 1024);
+    timer.restart();
+    dijkstra.buildArcFlags(32);
+    const ArcFlags &arcFlags = dijkstra.arcFlags();
+    out << QString("弧标志: %1 个区域  边界节点 %2  标志位占比 %3%  %4 ms  %5 KB\n")
+               .arg(arcFlags.regionCount())
+               .arg(arcFlags.boundaryNodeCount())
+               .arg(arcFlags.flaggedRatio() * 100, 0, 'f', 1)
+               .arg(timer.elapsed())
+               .arg(arcFlags.memoryUsage() / 1024);
+
+    QVector<long> reference;
+    double baseTime = 0;
+    for (const EngineCase &c : cases)
+    {
+        dijkstra.setQueryEngine(c.engine);
+        QVector<long> results;
+        qint64 settled = 0;
+        double ms = runQueries(dijkstra, queries, results, &settled);
+        if (reference.isEmpty())
+        {
+            reference = results;
+            baseTime = ms;
+        }
+        out << QString("%1  %2 ms  加速比 %3x  平均确定节点 %4  %5\n")
+                   .arg(QString(c.name), -20)
+                   .arg(ms, 10, 'f', 2)
+                   .arg(ms > 0 ? baseTime / ms : 0.0, 0, 'f', 2)
+                   .arg(queries.isEmpty() ? 0 : settled / queries.size())
+                   .arg(verdict(results == reference));
+        out.flush();
+    }
+    dijkstra.setQueryEngine(Dijkstra::EngineDijkstra);
+}
+
+// 中心点标签：单线程与多线程构建耗时、标签规模、序列化与载入耗时
+static void benchmarkHubLabels(Dijkstra &dijkstra)
+{
+    out << "\n== 中心点标签 ==\n";
+
+    QVector<int> threadCounts = { 1 };
+    if (QThread::idealThreadCount() > 1)
+        threadCounts.append(QThread::idealThreadCount());
+    for (int threads : threadCounts)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        dijkstra.buildHubLabels(threads);
+        const HubLabels &hub = dijkstra.hubLabels();
+        out << QString("构建 (%1 线程)  %2 ms  标签项 %3  平均 %4  最大 %5  %6 KB\n")
+                   .arg(threads)
+                   .arg(timer.elapsed())
+                   .arg(hub.entryCount())
+                   .arg(hub.averageLabelSize(), 0, 'f', 1)
+                   .arg(hub.maxLabelSize())
+                   .arg(hub.memoryUsage() / 1024);
+        out.flush();
+    }
+
+    QString fileName = QDir::temp().filePath("dijkstra_benchmark.hub");
+    QElapsedTimer timer;
+    timer.start();
+    bool saved = dijkstra.saveHubLabels(fileName);
+    qint64 saveMs = timer.restart();
+    bool loaded = saved && dijkstra.loadHubLabels(fileName);
+    qint64 loadMs = timer.elapsed();
+    out << QString("保存 %1 ms  载入 %2 ms  文件 %3 KB  %4\n")
+               .arg(saveMs)
+               .arg(loadMs)
+               .arg(QFileInfo(fileName).size() / 1024)
+               .arg(loaded ? "载入成功" : "载入失败!");
+    QFile::remove(fileName);
+    out.flush();
+}
+
+// delta-stepping 一对全：与单线程 Dijkstra 比较，并给出 1..N 线程的加速比
+static void benchmarkDeltaStepping(Dijkstra &dijkstra, const QVector<QPair<long, long>> &queries,
+                                   int sourceCount)
+{
+    out << "\n== 并行 delta-stepping（一对全）==\n";
+
+    const CsrGraph &csr = dijkstra.csrGraph();
+    QVector<int> sources;
+    for (int i = 0; i < queries.size() && sources.size() < sourceCount; i++)
+        sources.append(dijkstra.nodeIndex(queries[i].first));
+
+    QVector<QVector<long>> reference(sources.size());
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < sources.size(); i++)
+        csr.shortestPaths(sources[i], reference[i]);
+    double baseMs = timer.nsecsElapsed() / 1e6;
+    out << QString("%1  %2 ms\n").arg(QString("Dijkstra (4叉堆)"), -20).arg(baseMs, 10, 'f', 2);
+
+    QVector<int> threadCounts;
+    for (int threads = 1; threads < QThread::idealThreadCount(); threads *= 2)
+        threadCounts.append(threads);
+    threadCounts.append(QThread::idealThreadCount());
+
+    DeltaStepping delta;
+    double singleMs = 0;
+    for (int threads : threadCounts)
+    {
+        bool same = true;
+        timer.restart();
+        for (int i = 0; i < sources.size(); i++)
+        {
+            delta.run(csr, sources[i], threads);
+            same = same && delta.distances() == reference[i];
+        }
+        double ms = timer.nsecsElapsed() / 1e6;
+        if (threads == 1)
+            singleMs = ms;
+        out << QString("%1  %2 ms  相对 Dijkstra %3x  相对 1 线程 %4x  %5\n")
+                   .arg(QString("%1 线程").arg(threads), -20)
+                   .arg(ms, 10, 'f', 2)
+                   .arg(ms > 0 ? baseMs / ms : 0.0, 0, 'f', 2)
+                   .arg(ms > 0 ? singleMs / ms : 0.0, 0, 'f', 2)
+                   .arg(verdict(same));
+        out.flush();
+    }
+    out << QString("delta = %1  非空桶 %2  松弛轮数 %3（最后一个起点）\n")
+               .arg(delta.delta())
+               .arg(delta.bucketCount())
+               .arg(delta.phaseCount());
+}
+
+// 多对多距离矩阵：与逐对调用 getDistance 比较，并校验按对请求的路径长度
+static void benchmarkDistanceMatrix(Dijkstra &dijkstra, int size)
+{
+    out << QString("\n== 距离矩阵 (%1 × %1) ==\n").arg(size);
+
+    QVector<long> ids = dijkstra.getAllNodeIDs();
+    QRandomGenerator rng(20240602);
+    QVector<long> sources, targets;
+    for (int i = 0; i < size && !ids.isEmpty(); i++)
+    {
+        sources.append(ids[rng.bounded(ids.size())]);
+        targets.append(ids[rng.bounded(ids.size())]);
+    }
+
+    QVector<long> reference;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < sources.size(); i++)
+    {
+        for (int j = 0; j < targets.size(); j++)
+        {
+            long distance = 0;
+            QVector<long> path;
+            int ret = dijkstra.getDistance(sources[i], targets[j], distance, path);
+            reference.append(ret > 0 ? distance : CsrGraph::UNREACHABLE);
+        }
+    }
+    double pairMs = timer.nsecsElapsed() / 1e6;
+    out << QString("%1  %2 ms\n").arg(QString("逐对 getDistance"), -20).arg(pairMs, 10, 'f', 2);
+
+    // 对角线上的每一对同时请求路径
+    QVector<QPair<int, int>> pathPairs;
+    for (int i = 0; i < sources.size(); i++)
+        pathPairs.append(qMakePair(i, i));
+
+    QVector<int> threadCounts = { 1 };
+    if (QThread::idealThreadCount() > 1)
+        threadCounts.append(QThread::idealThreadCount());
+    for (int threads : threadCounts)
+    {
+        QVector<long> distances;
+        QVector<QVector<long>> paths;
+        timer.restart();
+        dijkstra.distanceMatrix(sources, targets, distances, pathPairs, &paths, threads);
+        double ms = timer.nsecsElapsed() / 1e6;
+
+        bool pathsValid = true;
+        for (int k = 0; k < paths.size(); k++)
+        {
+            long length = 0;
+            for (int i = 1; i < paths[k].size(); i++)
+                length += dijkstra.getNodeNeighbors(paths[k][i - 1]).value(paths[k][i], CsrGraph::UNREACHABLE);
+            long expected = distances[pathPairs[k].first * targets.size() + pathPairs[k].second];
+            if (paths[k].isEmpty() ? expected < CsrGraph::UNREACHABLE : length != expected)
+                pathsValid = false;
+        }
+        if (!pathsValid)
+            mismatchCount++;
+        out << QString("%1  %2 ms  加速比 %3x  %4  %5\n")
+                   .arg(QString("distanceMatrix %1 线程").arg(threads), -20)
+                   .arg(ms, 10, 'f', 2)
+                   .arg(ms > 0 ? pairMs / ms : 0.0, 0, 'f', 2)
+                   .arg(verdict(distances == reference))
+                   .arg(pathsValid ? "路径正确" : "路径错误!");
+        out.flush();
+    }
+}
+
+// 全源距离矩阵：分两段构建（模拟中断后续算），载入后由 getDistance 直接查表
+static void benchmarkAllPairs(Dijkstra &dijkstra, const QVector<QPair<long, long>> &queries)
+{
+    out << "\n== 全源距离矩阵 (内存映射) ==\n";
+
+    const CsrGraph &csr = dijkstra.csrGraph();
+    qint64 bytes = AllPairsMatrix::matrixBytes(csr);
+    if (bytes > (qint64(1) << 30))
+    {
+        out << QString("矩阵 %1 MB，超过 1 GB，跳过\n").arg(bytes >> 20);
+        return;
+    }
+
+    QVector<long> reference;
+    double engineMs = runQueries(dijkstra, queries, reference);
+
+    QString fileName = QDir::temp().filePath("dijkstra_benchmark.apsp");
+    QFile::remove(fileName);
+    int half = csr.nodeCount() / 2;
+    QElapsedTimer timer;
+    timer.start();
+    dijkstra.buildAllPairs(fileName, 0, half);
+    qint64 firstMs = timer.restart();
+    dijkstra.buildAllPairs(fileName);
+    qint64 resumeMs = timer.elapsed();
+    out << QString("构建 %1 行  %2 ms  断点续算 %3 行  %4 ms  文件 %5 MB\n")
+               .arg(half)
+               .arg(firstMs)
+               .arg(csr.nodeCount() - half)
+               .arg(resumeMs)
+               .arg(QFileInfo(fileName).size() >> 20);
+
+    bool loaded = dijkstra.loadAllPairs(fileName);
+    QVector<long> results;
+    double ms = runQueries(dijkstra, queries, results);
+    out << QString("载入 %1  每项 %2 字节\n")
+               .arg(loaded ? "成功" : "失败!")
+               .arg(dijkstra.allPairs().elementSize());
+    out << QString("%1  %2 ms\n").arg(QString("查询引擎"), -20).arg(engineMs, 10, 'f', 2);
+    out << QString("%1  %2 ms  加速比 %3x  %4\n")
+               .arg(QString("矩阵查表"), -20)
+               .arg(ms, 10, 'f', 2)
+               .arg(ms > 0 ? engineMs / ms : 0.0, 0, 'f', 2)
+               .arg(verdict(results == reference));
+
+    dijkstra.closeAllPairs();
+    QFile::remove(fileName);
+    out.flush();
+}
+
+// 小图距离表：比较各指令集实现的分块 Floyd–Warshall 构建耗时，以及查表与查询引擎的耗时
+// O(n^3) 构建只适合可视化规模的图，节点数超过 maxNodes 时跳过
+static void benchmarkFloydWarshall(Dijkstra &dijkstra, const QVector<QPair<long, long>> &queries, int maxNodes)
+{
+    out << "\n== 小图距离表 (分块 Floyd–Warshall) ==\n";
+
+    int n = dijkstra.csrGraph().nodeCount();
+    if (n > maxNodes)
+    {
+        out << QString("节点数 %1 超过 %2，跳过\n").arg(n).arg(maxNodes);
+        return;
+    }
+
+    QVector<long> reference;
+    double engineMs = runQueries(dijkstra, queries, reference);
+
+    const FloydWarshall::Kernel kernels[] = { FloydWarshall::KernelScalar, FloydWarshall::KernelSse2,
+                                              FloydWarshall::KernelAvx2 };
+    double scalarMs = 0;
+    for (FloydWarshall::Kernel kernel : kernels)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        bool built = dijkstra.buildFloydWarshall(kernel);
+        double ms = timer.nsecsElapsed() / 1e6;
+        if (!built)
+        {
+            out << "构建失败（距离超出 32 位或存在负边权），跳过\n";
+            return;
+        }
+        FloydWarshall::Kernel used = dijkstra.floydWarshall().kernel();
+        if (used != kernel)
+        {
+            out << QString("%1  CPU 不支持\n").arg(QString(FloydWarshall::kernelName(kernel)), -20);
+            continue;
+        }
+        if (kernel == FloydWarshall::KernelScalar)
+            scalarMs = ms;
+        out << QString("%1  构建 %2 ms  加速比 %3x\n")
+                   .arg(QString(FloydWarshall::kernelName(kernel)), -20)
+                   .arg(ms, 10, 'f', 2)
+                   .arg(ms > 0 ? scalarMs / ms : 0.0, 0, 'f', 2);
+    }
+    out << QString("距离表 %1 KB\n").arg(dijkstra.floydWarshall().memoryUsage() >> 10);
+
+    dijkstra.setFloydWarshallLimit(n);
+    QVector<long> results;
+    double ms = runQueries(dijkstra, queries, results);
+    dijkstra.setFloydWarshallLimit(0);
+    out << QString("%1  %2 ms\n").arg(QString("查询引擎"), -20).arg(engineMs, 10, 'f', 2);
+    out << QString("%1  %2 ms  加速比 %3x  %4\n")
+               .arg(QString("距离表查表"), -20)
+               .arg(ms, 10, 'f', 2)
+               .arg(ms > 0 ? engineMs / ms : 0.0, 0, 'f', 2)
+               .arg(verdict(results == reference));
+    out.flush();
+}
+
+// 随机修改一批边权后，比较 CCH 重新定制与 CH 完整重建的耗时，并校验定制后的查询结果
+// 会修改图数据，放在最后执行
+static void benchmarkCustomization(Dijkstra &dijkstra, const QVector<QPair<long, long>> &queries,
+                                   int editCount)
+{
+    out << "\n== 边权修改后重新定制 ==\n";
+
+    if (dijkstra.customizableCH().isEmpty())
+        dijkstra.buildCustomizableCH();
+
+    const CsrGraph &csr = dijkstra.csrGraph();
+    QRandomGenerator rng(20240607);
+    int edited = 0;
+    for (int i = 0; i < editCount; i++)
+    {
+        int u = 1 + rng.bounded(csr.nodeCount());
+        if (csr.degree(u) == 0)
+            continue;
+        int e = csr.offsets[u] + rng.bounded(csr.degree(u));
+        int v = csr.targets[e];
+        if (v == u)
+            continue;
+        long weight = qMax(1L, csr.weights[e] * (50 + rng.bounded(100)) / 100);
+        if (dijkstra.setEdgeDistance(dijkstra.nodeID(u), dijkstra.nodeID(v), weight))
+            edited++;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    dijkstra.customizeCH();
+    double customizeMs = timer.nsecsElapsed() / 1e6;
+
+    timer.restart();
+    dijkstra.buildContractionHierarchy();
+    double rebuildMs = timer.nsecsElapsed() / 1e6;
+
+    out << QString("修改 %1 条边  CCH 重新定制 %2 ms  CH 完整重建 %3 ms\n")
+               .arg(edited)
+               .arg(customizeMs, 0, 'f', 2)
+               .arg(rebuildMs, 0, 'f', 2);
+
+    QVector<long> reference, results;
+    dijkstra.setQueryEngine(Dijkstra::EngineDijkstra);
+    runQueries(dijkstra, queries, reference);
+    dijkstra.setQueryEngine(Dijkstra::EngineCCH);
+    double ms = runQueries(dijkstra, queries, results);
+    out << QString("定制后 CCH 查询  %1 ms  %2\n")
+               .arg(ms, 0, 'f', 2)
+               .arg(verdict(results == reference));
+    dijkstra.setQueryEngine(Dijkstra::EngineDijkstra);
+    out.flush();
+}
+
+// 增量修复：同一起点的查询之间穿插修改边权，比较每次修改后重新搜索与就地修复最短路径树
+static void benchmarkIncrementalRepair(Dijkstra &dijkstra, int editCount)
+{
+    out << "\n== 修改边权后的最短路径树修复 ==\n";
+    struct Edit
+    {
+        long id1, id2, weight, oldWeight;
+    };
+    const CsrGraph &csr = dijkstra.csrGraph();
+    QVector<long> ids = dijkstra.getAllNodeIDs();
+    QRandomGenerator rng(20240621);
+    QVector<Edit> edits;
+    QVector<long> targets;
+    for (int i = 0; i < editCount; i++)
+    {
+        int u = 1 + rng.bounded(csr.nodeCount());
+        if (csr.degree(u) == 0)
+            continue;
+        int e = csr.offsets[u] + rng.bounded(csr.degree(u));
+        int v = csr.targets[e];
+        if (v == u)
+            continue;
+        long weight = qMax(1L, csr.weights[e] * (50 + rng.bounded(100)) / 100);
+        edits.append(Edit{dijkstra.nodeID(u), dijkstra.nodeID(v), weight, csr.weights[e]});
+        targets.append(ids[rng.bounded(int(ids.size()))]);
+    }
+    long source = ids[rng.bounded(int(ids.size()))];
+
+    // 依次修改并查询，之后按相反顺序恢复原边权
+    auto run = [&dijkstra, &edits, &targets, source](QVector<long> &results) {
+        results.clear();
+        long distance = 0;
+        QVector<long> path;
+        dijkstra.getDistance(source, targets.first(), distance, path);
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < edits.size(); i++)
+        {
+            dijkstra.setEdgeDistance(edits[i].id1, edits[i].id2, edits[i].weight);
+            int ret = dijkstra.getDistance(source, targets[i], distance, path);
+            results.append(ret > 0 ? distance : -1);
+        }
+        double ms = timer.nsecsElapsed() / 1e6;
+        for (int i = edits.size() - 1; i >= 0; i--)
+            dijkstra.setEdgeDistance(edits[i].id1, edits[i].id2, edits[i].oldWeight);
+        return ms;
+    };
+
+    // 修复只作用于完整的树，两种方式都关闭提前终止，比较的是整棵树的重算与修复
+    QVector<long> rebuildResults, repairResults;
+    dijkstra.setEarlyTermination(false);
+    double rebuildMs = run(rebuildResults);
+    dijkstra.setIncrementalRepair(true);
+    double repairMs = run(repairResults);
+    dijkstra.setIncrementalRepair(false);
+    dijkstra.setEarlyTermination(true);
+
+    out << QString("%1 次修改，每次修改后查询一次\n").arg(edits.size());
+    out << QString("重新搜索  %1 ms\n").arg(rebuildMs, 10, 'f', 2);
+    out << QString("增量修复  %1 ms  加速比 %2x  %3\n")
+               .arg(repairMs, 10, 'f', 2)
+               .arg(repairMs > 0 ? rebuildMs / repairMs : 0.0, 0, 'f', 2)
+               .arg(verdict(repairResults == rebuildResults));
+    out.flush();
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QStringList args = app.arguments();
+
+    QString fileName = args.size() > 1 ? args[1]
+                                       : QString("../../Dijkstra算法/结点距离数据(较多).txt");
+    int queryCount = args.size() > 2 ? args[2].toInt() : 50;
+
+    Dijkstra dijkstra;
+    QElapsedTimer timer;
+    timer.start();
+    if (!dijkstra.loadFileData(fileName))
+    {
+        out << "加载失败: " << dijkstra.errorDescription() << "\n";
+        return 1;
+    }
+    Dijkstra::GraphStats stats = dijkstra.getGraphStats();
+    out << QString("数据文件: %1\n节点: %2  边: %3  加载耗时: %4 ms\n")
+               .arg(QFileInfo(fileName).fileName())
+               .arg(stats.nodeCount).arg(stats.edgeCount)
+               .arg(timer.elapsed());
+    const CsrGraph &csr = dijkstra.csrGraph();
+    out << QString("CSR邻接数组: %1 KB（每条有向边 %2 字节）\n")
+               .arg(csr.memoryUsage() / 1024)
+               .arg(csr.arcCount() > 0 ? double(csr.memoryUsage()) / csr.arcCount() : 0.0, 0, 'f', 1);
+    out << QString("查询次数: %1\n").arg(queryCount);
+
+    // 重复的查询序列会命中最短路径树缓存，各测试默认关闭，只在缓存测试中打开
+    dijkstra.setTreeCacheBudget(0);
+
+    QVector<QPair<long, long>> queries = makeQueries(dijkstra, queryCount);
+    benchmarkQueues(dijkstra, queries);
+    benchmarkEarlyTermination(dijkstra, queries);
+    benchmarkTreeCache(dijkstra, queries, 8, queryCount * 4);
+    benchmarkConcurrentQueries(dijkstra, queries);
+    benchmarkPolicySearch(dijkstra, queries);
+    benchmarkIdLookup(dijkstra, 20);
+    benchmarkNodeOrder(fileName, queries, 300);
+    benchmarkEngines(dijkstra, queries);
+    benchmarkHubLabels(dijkstra);
+    benchmarkDeltaStepping(dijkstra, queries, 20);
+    benchmarkDistanceMatrix(dijkstra, 20);
+    benchmarkMultiSourceBfs(dijkstra, 256);
+    benchmarkLaneBatch(dijkstra, 64);
+    benchmarkAllPairs(dijkstra, queries);
+    benchmarkFloydWarshall(dijkstra, queries, 2000);
+    benchmarkDenseGraphs(2000, 200);
+    benchmarkCustomization(dijkstra, queries, 1000);
+    benchmarkIncrementalRepair(dijkstra, 200);
+
+    if (mismatchCount > 0)
+    {
+        out << QString("\n%1 项测试结果不一致\n").arg(mismatchCount);
+        return 2;
+    }
+    return 0;
+}
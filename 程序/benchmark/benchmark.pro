@@ -0,0 +1,59 @@
+# Dijkstra 算法性能基准测试（命令行程序）
+# 用法：
+#   qmake && make
+#   ./DijkstraBenchmark [数据文件] [查询次数]
+# 默认数据文件为 ../../Dijkstra算法/结点距离数据(较多).txt
+
+QT += core concurrent
+QT -= gui
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = DijkstraBenchmark
+TEMPLATE = app
+
+INCLUDEPATH += ..
+
+SOURCES += \
+    benchmark.cpp \
+    ../dijkstra.cpp \
+    ../dijkstra_csr.cpp \
+    ../dijkstra_alt.cpp \
+    ../dijkstra_ch.cpp \
+    ../dijkstra_cch.cpp \
+    ../dijkstra_hub.cpp \
+    ../dijkstra_arcflags.cpp \
+    ../dijkstra_delta.cpp \
+    ../dijkstra_matrix.cpp \
+    ../dijkstra_apsp.cpp \
+    ../dijkstra_floyd.cpp \
+    ../dijkstra_dense.cpp \
+    ../dijkstra_bfs.cpp \
+    ../dijkstra_lanes.cpp \
+    ../dijkstra_treecache.cpp \
+    ../dijkstra_idmap.cpp \
+    ../dijkstra_order.cpp
+
+HEADERS += \
+    ../dijkstra.h \
+    ../dijkstra_heap.h \
+    ../dijkstra_csr.h \
+    ../dijkstra_alt.h \
+    ../dijkstra_ch.h \
+    ../dijkstra_cch.h \
+    ../dijkstra_hub.h \
+    ../dijkstra_arcflags.h \
+    ../dijkstra_delta.h \
+    ../dijkstra_matrix.h \
+    ../dijkstra_apsp.h \
+    ../dijkstra_floyd.h \
+    ../dijkstra_dense.h \
+    ../dijkstra_bfs.h \
+    ../dijkstra_lanes.h \
+    ../dijkstra_treecache.h \
+    ../dijkstra_workspace.h \
+    ../dijkstra_basic.h \
+    ../dijkstra_idmap.h \
+    ../dijkstra_order.h \
+    ../dijkstra_simd.h
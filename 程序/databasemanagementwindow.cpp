@@ -1,6 +1,8 @@
 #include "databasemanagementwindow.h"
 #include "graphdatabase.h"
 #include "dijkstra.h"
+#include "graphsnapshot.h"
+#include "dijkstra_loader.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QGridLayout>
@@ -15,11 +17,17 @@
 #include <QInputDialog>
 #include <QDateTime>
 
-DatabaseManagementWindow::DatabaseManagementWindow(GraphDatabase *db, Dijkstra *dijkstra, QWidget *parent)
+DatabaseManagementWindow::DatabaseManagementWindow(GraphDatabase *db, GraphSnapshotStore *graphs, QWidget *parent)
     : QMainWindow(parent)
     , m_db(db)
-    , m_dijkstra(dijkstra)
+    , m_graphs(graphs)
+    , m_dijkstra(graphs->current())
+    , m_loader(new DijkstraLoader(this))
 {
+    connect(graphs, &GraphSnapshotStore::graphPublished, this, [this]() {
+        m_dijkstra = m_graphs->current();
+    });
+    connect(m_loader, &DijkstraLoader::finished, this, &DatabaseManagementWindow::onTableLoadFinished);
     setupUI();
     refreshTableList();
 }
@@ -203,17 +211,9 @@ void DatabaseManagementWindow::onUseTable()
     
     if (m_db->setCurrentTable(tableName))
     {
-        // 加载数据到Dijkstra
-        if (m_dijkstra && m_db->loadGraph(m_dijkstra, tableName))
-        {
-            m_statusLabel->setText(QString("已切换到表格: %1").arg(tableName));
-            emit tableSwitched(tableName);
-            QMessageBox::information(this, "成功", QString("已切换到表格: %1\n数据已加载到内存").arg(tableName));
-        }
-        else
-        {
-            QMessageBox::warning(this, "警告", QString("切换到表格 %1 成功，但加载数据失败:\n%2").arg(tableName).arg(m_db->lastError()));
-        }
+        // 在工作线程中加载到新图，完成后替换当前图（见 onTableLoadFinished）
+        m_statusLabel->setText(QString("正在加载表格: %1").arg(tableName));
+        m_loader->loadTable(m_db->databasePath(), tableName, m_graphs->createGraph());
     }
     else
     {
@@ -221,6 +221,22 @@ void DatabaseManagementWindow::onUseTable()
     }
 }
 
+void DatabaseManagementWindow::onTableLoadFinished(bool success, const QString &error)
+{
+    QString tableName = m_loader->getTableName();
+    if (!success)
+    {
+        m_statusLabel->setText(QString("加载表格失败: %1").arg(tableName));
+        QMessageBox::warning(this, "警告", QString("切换到表格 %1 成功，但加载数据失败:\n%2").arg(tableName).arg(error));
+        return;
+    }
+
+    m_graphs->publish(m_loader->takeLoadedGraph());
+    m_statusLabel->setText(QString("已切换到表格: %1").arg(tableName));
+    emit tableSwitched(tableName);
+    QMessageBox::information(this, "成功", QString("已切换到表格: %1\n数据已加载到内存").arg(tableName));
+}
+
 void DatabaseManagementWindow::onCreateTable()
 {
     QString tableName = m_editTableName->text().trimmed();
@@ -8,16 +8,19 @@
 #include <QLabel>
 #include <QTextEdit>
 #include <QGroupBox>
+#include <QSharedPointer>
 
 class GraphDatabase;
 class Dijkstra;
+class DijkstraLoader;
+class GraphSnapshotStore;
 
 class DatabaseManagementWindow : public QMainWindow
 {
     Q_OBJECT
 
 public:
-    explicit DatabaseManagementWindow(GraphDatabase *db, Dijkstra *dijkstra, QWidget *parent = nullptr);
+    explicit DatabaseManagementWindow(GraphDatabase *db, GraphSnapshotStore *graphs, QWidget *parent = nullptr);
     ~DatabaseManagementWindow();
 
 public slots:
@@ -30,12 +33,17 @@ public slots:
 signals:
     void tableSwitched(const QString &tableName);
 
+private slots:
+    void onTableLoadFinished(bool success, const QString &error);
+
 private:
     void setupUI();
     void updateTableInfo();
     
     GraphDatabase *m_db;
-    Dijkstra *m_dijkstra;
+    GraphSnapshotStore *m_graphs;
+    QSharedPointer<const Dijkstra> m_dijkstra;  // 当前图，随 m_graphs 的发布更新
+    DijkstraLoader *m_loader;       // 在工作线程中载入表格
     
     // UI组件
     QTableWidget *m_tableList;
@@ -1,6 +1,8 @@
 #include "datamanagementwindow.h"
 #include "dijkstra.h"
 #include "graphdatabase.h"
+#include "graphsnapshot.h"
+#include "dijkstra_loader.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QGridLayout>
@@ -22,10 +24,12 @@
 #include <algorithm>
 #include <climits>
 
-DataManagementWindow::DataManagementWindow(Dijkstra *dijkstra, GraphDatabase *db, QWidget *parent)
+DataManagementWindow::DataManagementWindow(GraphSnapshotStore *graphs, GraphDatabase *db, QWidget *parent)
     : QMainWindow(parent)
-    , m_dijkstra(dijkstra)
+    , m_graphs(graphs)
+    , m_dijkstra(graphs->current())
     , m_db(db)
+    , m_loader(new DijkstraLoader(this))
     , m_selectedNodeRow(-1)
     , m_selectedEdgeRow(-1)
     , m_nodePage(0)
@@ -33,6 +37,10 @@ DataManagementWindow::DataManagementWindow(Dijkstra *dijkstra, GraphDatabase *db
     , m_nodeTotalPages(0)
     , m_edgeTotalPages(0)
 {
+    connect(graphs, &GraphSnapshotStore::graphPublished, this, [this]() {
+        m_dijkstra = m_graphs->current();
+    });
+    connect(m_loader, &DijkstraLoader::finished, this, &DataManagementWindow::onTableLoadFinished);
     setupUI();
     refreshData();
 }
@@ -456,8 +464,7 @@ void DataManagementWindow::updateStatistics()
     
     if (stats.nodeCount > 0)
     {
-        double density = (double)stats.edgeCount / (stats.nodeCount * (stats.nodeCount - 1) / 2.0);
-        statsText += QString("\n图密度: %1\n").arg(density, 0, 'f', 4);
+        statsText += QString("\n图密度: %1\n").arg(stats.density, 0, 'f', 4);
     }
 
     m_statsText->setPlainText(statsText);
@@ -599,9 +606,23 @@ void DataManagementWindow::onAddNode()
     
     // 添加一个虚拟边来创建节点（或者需要扩展Dijkstra类支持直接添加节点）
     // 暂时通过添加自环边来创建节点
-    if (m_dijkstra->addNodesDist(id, id, 0))
+    bool ok;
+    QString error;
+    {
+        GraphWriter graph(m_graphs);
+        ok = graph->addNodesDist(id, id, 0);
+        if (ok)
+        {
+            graph.markChanged();
+            graph->setNodeLabel(id, label);
+        }
+        else
+        {
+            error = graph->errorDescription();
+        }
+    }
+    if (ok)
     {
-        m_dijkstra->setNodeLabel(id, label);
         if (m_db)
         {
             m_db->addOrUpdateNode(id, label.isEmpty() ? QString::number(id) : label);
@@ -612,7 +633,7 @@ void DataManagementWindow::onAddNode()
     }
     else
     {
-        QMessageBox::critical(this, "错误", m_dijkstra->errorDescription());
+        QMessageBox::critical(this, "错误", error);
     }
 }
 
@@ -634,7 +655,8 @@ void DataManagementWindow::onEditNode()
     if (newLabel.isEmpty())
         return;
     
-    m_dijkstra->setNodeLabel(id, newLabel);
+    // 标签不影响查询，直接修改当前图，不重新发布
+    GraphWriter(m_graphs)->setNodeLabel(id, newLabel);
     if (m_db)
         m_db->addOrUpdateNode(id, newLabel);
     refreshData();
@@ -669,7 +691,17 @@ void DataManagementWindow::onAddEdge()
     if (!validateEdgeInput(id1, id2, distance))
         return;
     
-    if (m_dijkstra->addNodesDist(id1, id2, distance))
+    bool ok;
+    QString error;
+    {
+        GraphWriter graph(m_graphs);
+        ok = graph->addNodesDist(id1, id2, distance);
+        if (ok)
+            graph.markChanged();
+        else
+            error = graph->errorDescription();
+    }
+    if (ok)
     {
         if (m_db)
         {
@@ -682,7 +714,7 @@ void DataManagementWindow::onAddEdge()
     }
     else
     {
-        QMessageBox::critical(this, "错误", m_dijkstra->errorDescription());
+        QMessageBox::critical(this, "错误", error);
     }
 }
 
@@ -698,17 +730,34 @@ void DataManagementWindow::onEditEdge()
     if (!id1Item || !id2Item || !distItem)
         return;
     
+    long id1 = id1Item->text().toLong();
+    long id2 = id2Item->text().toLong();
     long oldDist = distItem->text().toLong();
     
-    // 先删除旧边，再添加新边
-    // 注意：需要扩展Dijkstra类支持删除边
     bool ok;
     long newDist = QInputDialog::getInt(this, "编辑边距离", "新距离:", oldDist, 1, INT_MAX, 1, &ok);
-    Q_UNUSED(newDist);
+    if (!ok || newDist == oldDist)
+        return;
     
+    // 只修改边权，图的拓扑不变
+    QString error;
+    {
+        GraphWriter graph(m_graphs);
+        ok = graph->setEdgeDistance(id1, id2, newDist);
+        if (ok)
+            graph.markChanged();
+        else
+            error = graph->errorDescription();
+    }
     if (ok)
     {
-        QMessageBox::information(this, "提示", "编辑边功能需要扩展Dijkstra类支持删除边");
+        if (m_db)
+            m_db->addOrUpdateEdge(id1, id2, newDist);
+        refreshData();
+    }
+    else
+    {
+        QMessageBox::critical(this, "错误", error);
     }
 }
 
@@ -816,13 +865,16 @@ void DataManagementWindow::onImportData()
         QApplication::processEvents();
     };
     
-    if (m_dijkstra->loadFileData(fileName, progressCallback))
+    // 在新图中导入，失败时当前图保持不变
+    QSharedPointer<Dijkstra> graph = m_graphs->createGraph();
+    if (graph->loadFileData(fileName, progressCallback))
     {
         progress.close();
+        m_graphs->publish(graph);
         if (m_db)
         {
             m_db->clear();
-            m_db->saveGraph(m_dijkstra);
+            m_db->saveGraph(m_dijkstra.data());
         }
         refreshData();
         QMessageBox::information(this, "成功", QString("成功导入数据！\n节点数量: %1").arg(m_dijkstra->nodeCount()));
@@ -830,7 +882,7 @@ void DataManagementWindow::onImportData()
     else
     {
         progress.close();
-        QMessageBox::critical(this, "错误", QString("导入失败:\n%1").arg(m_dijkstra->errorDescription()));
+        QMessageBox::critical(this, "错误", QString("导入失败:\n%1").arg(graph->errorDescription()));
     }
 }
 
@@ -887,17 +939,28 @@ void DataManagementWindow::onLoadFromDatabase()
         QMessageBox::critical(this, "错误", QString("切换到表格失败:\n%1").arg(m_db->lastError()));
         return;
     }
-    if (!m_db->loadGraph(m_dijkstra, tableName))
+
+    // 在工作线程中加载到新图，完成后替换当前图（见 onTableLoadFinished）
+    m_loadingTableName = tables[index].displayName.isEmpty() ? tableName : tables[index].displayName;
+    m_statusLabel->setText(QString("正在加载表格: %1").arg(m_loadingTableName));
+    m_loader->loadTable(m_db->databasePath(), tableName, m_graphs->createGraph());
+}
+
+void DataManagementWindow::onTableLoadFinished(bool success, const QString &error)
+{
+    if (!success)
     {
-        QMessageBox::critical(this, "错误", QString("从表格加载失败:\n%1").arg(m_db->lastError()));
+        m_statusLabel->setText("从表格加载失败");
+        QMessageBox::critical(this, "错误", QString("从表格加载失败:\n%1").arg(error));
         return;
     }
+    m_graphs->publish(m_loader->takeLoadedGraph());
 
     m_nodePage = 0;
     m_edgePage = 0;
     refreshData();
     QMessageBox::information(this, "成功", QString("已从表格 \"%1\" 加载图数据，节点数量: %2")
-                                             .arg(tables[index].displayName.isEmpty() ? tableName : tables[index].displayName)
+                                             .arg(m_loadingTableName)
                                              .arg(m_dijkstra->nodeCount()));
 }
 
@@ -985,7 +1048,7 @@ void DataManagementWindow::onSaveToDatabase()
         return;
     }
 
-    if (!m_db->saveGraph(m_dijkstra, tableName))
+    if (!m_db->saveGraph(m_dijkstra.data(), tableName))
     {
         QMessageBox::critical(this, "错误", QString("保存到数据库失败:\n%1").arg(m_db->lastError()));
         return;
@@ -1014,60 +1077,65 @@ void DataManagementWindow::onPasteImport()
     }
     int successCount = 0;
     int failCount = 0;
-    for (const QString &lineRaw : lines)
+    // 全部行在同一次写入中导入
     {
-        QString line = lineRaw.trimmed();
-        if (line.isEmpty())
-            continue;
-
-        QStringList parts;
-        if (line.contains('\t'))
-            parts = line.split('\t', Qt::SkipEmptyParts);
-        else if (line.contains(','))
-            parts = line.split(',', Qt::SkipEmptyParts);
-        else if (line.contains(';'))
-            parts = line.split(';', Qt::SkipEmptyParts);
-        else
-            // 使用空格分割（支持多个空格）
-            parts = line.split(' ', Qt::SkipEmptyParts);
-            // 如果分割后元素不足，尝试用制表符分割
+        GraphWriter graph(m_graphs);
+        for (const QString &lineRaw : lines)
+        {
+            QString line = lineRaw.trimmed();
+            if (line.isEmpty())
+                continue;
+
+            QStringList parts;
+            if (line.contains('\t'))
+                parts = line.split('\t', Qt::SkipEmptyParts);
+            else if (line.contains(','))
+                parts = line.split(',', Qt::SkipEmptyParts);
+            else if (line.contains(';'))
+                parts = line.split(';', Qt::SkipEmptyParts);
+            else
+                // 使用空格分割（支持多个空格）
+                parts = line.split(' ', Qt::SkipEmptyParts);
+                // 如果分割后元素不足，尝试用制表符分割
+                if (parts.size() < 3)
+                {
+                    parts = line.split('\t', Qt::SkipEmptyParts);
+                }
+
             if (parts.size() < 3)
             {
-                parts = line.split('\t', Qt::SkipEmptyParts);
+                failCount++;
+                continue;
             }
 
-        if (parts.size() < 3)
-        {
-            failCount++;
-            continue;
-        }
-
-        bool ok1, ok2, ok3;
-        long id1 = parts[0].toLong(&ok1);
-        long id2 = parts[1].toLong(&ok2);
-        long dist = parts[2].toLong(&ok3);
-        if (!ok1 || !ok2 || !ok3)
-        {
-            failCount++;
-            continue;
-        }
+            bool ok1, ok2, ok3;
+            long id1 = parts[0].toLong(&ok1);
+            long id2 = parts[1].toLong(&ok2);
+            long dist = parts[2].toLong(&ok3);
+            if (!ok1 || !ok2 || !ok3)
+            {
+                failCount++;
+                continue;
+            }
 
-        if (m_dijkstra->addNodesDist(id1, id2, dist))
-        {
-            if (m_db)
+            if (graph->addNodesDist(id1, id2, dist))
             {
-                m_db->addOrUpdateNode(id1, m_dijkstra->getNodeLabel(id1));
-                m_db->addOrUpdateNode(id2, m_dijkstra->getNodeLabel(id2));
-                m_db->addOrUpdateEdge(id1, id2, dist);
+                if (m_db)
+                {
+                    m_db->addOrUpdateNode(id1, graph->getNodeLabel(id1));
+                    m_db->addOrUpdateNode(id2, graph->getNodeLabel(id2));
+                    m_db->addOrUpdateEdge(id1, id2, dist);
+                }
+                successCount++;
+            }
+            else
+            {
+                failCount++;
             }
-            successCount++;
-        }
-        else
-        {
-            failCount++;
         }
+        if (successCount > 0)
+            graph.markChanged();
     }
-
     refreshData();
     QMessageBox::information(this, "导入完成",
                              QString("成功导入 %1 行，失败 %2 行。").arg(successCount).arg(failCount));
@@ -12,16 +12,19 @@
 #include <QComboBox>
 #include <QCheckBox>
 #include <QTime>
+#include <QSharedPointer>
 
 class Dijkstra;
+class DijkstraLoader;
 class GraphDatabase;
+class GraphSnapshotStore;
 
 class DataManagementWindow : public QMainWindow
 {
     Q_OBJECT
 
 public:
-    explicit DataManagementWindow(Dijkstra *dijkstra, GraphDatabase *db, QWidget *parent = nullptr);
+    explicit DataManagementWindow(GraphSnapshotStore *graphs, GraphDatabase *db, QWidget *parent = nullptr);
     ~DataManagementWindow();
 
 public slots:
@@ -50,6 +53,7 @@ private slots:
     void onNodeNextPage();
     void onEdgePrevPage();
     void onEdgeNextPage();
+    void onTableLoadFinished(bool success, const QString &error);
 
 private:
     void setupUI();
@@ -63,8 +67,11 @@ private:
     bool validateNodeInput(long &id, QString &label);
     bool validateEdgeInput(long &id1, long &id2, long &distance);
 
-    Dijkstra *m_dijkstra;
+    GraphSnapshotStore *m_graphs;
+    QSharedPointer<const Dijkstra> m_dijkstra;  // 当前图，随 m_graphs 的发布更新
     GraphDatabase *m_db;
+    DijkstraLoader *m_loader;       // 在工作线程中载入表格
+    QString m_loadingTableName;     // 正在载入的表格（显示名）
 
     // UI组件
     QTableWidget *m_nodeTable;
@@ -3,14 +3,146 @@
 #include <QTextStream>
 #include <QStringList>
 #include <QDebug>
+#include <QThread>
+#include <QtConcurrent>
 #include <algorithm>
 #include <cmath>
 
-const long Dijkstra::MAX_DISTANCE = 999999999;
+const long Dijkstra::MAX_DISTANCE = CsrGraph::UNREACHABLE;
+const long Dijkstra::DIAL_MAX_WEIGHT = DialQueue::MAX_WEIGHT;
+const double Dijkstra::DEFAULT_DENSE_THRESHOLD = 0.15;
+
+namespace {
+
+// Dijkstra::query / queryDistance 的点对点搜索：与 getDistance 选用相同的队列，终点确定即停止
+// 矩阵搜索的状态属于实例，改用4叉堆。返回是否已遍历整个连通分量
+template <typename Search>
+bool searchTarget(Search search, const CsrGraph &graph, Dijkstra::QueueType queueType, QueryWorkspace &work,
+                  int iStart, int iEnd)
+{
+    auto run = [&search, iStart, iEnd](auto &queue) {
+        search.start(queue, iStart);
+        return search.run(queue, iEnd);
+    };
+
+    switch (queueType)
+    {
+    case Dijkstra::QueueDialBuckets:
+        work.dialQueue.setMaxWeight(graph.maxWeight);
+        return run(work.dialQueue);
+    case Dijkstra::QueueRadixHeap:
+        return run(work.radixHeap);
+    case Dijkstra::QueueBfs:
+        return run(work.fifoQueue);
+    default:
+        return run(work.daryHeap);
+    }
+}
+
+// 由搜索状态生成最短路径树：settled 为已确定的节点（任意顺序）
+// 确定的节点不少于 1/8 时稠密存放（填充 n + 1 项的代价不超过确定节点数的常数倍，且省去排序），
+// 否则稀疏存放，排序和复制只涉及确定的节点
+template <typename State>
+QSharedPointer<ShortestPathTree> makeSearchTree(int source, quint64 graphVersion, bool complete, int nodeCount,
+                                                QVector<int> settled, const State &state)
+{
+    QSharedPointer<ShortestPathTree> tree(new ShortestPathTree);
+    tree->source = source;
+    tree->graphVersion = graphVersion;
+    tree->complete = complete;
+    tree->settledCount = settled.size();
+    if (qint64(settled.size()) * 8 >= qint64(nodeCount + 1))
+    {
+        tree->distance.fill(CsrGraph::UNREACHABLE, nodeCount + 1);
+        tree->parent.fill(0, nodeCount + 1);
+        for (int v : settled)
+        {
+            tree->distance[v] = state.distance(v);
+            tree->parent[v] = state.firstParent(v);
+        }
+        return tree;
+    }
+
+    std::sort(settled.begin(), settled.end());
+    tree->distance.resize(settled.size());
+    tree->parent.resize(settled.size());
+    for (int k = 0; k < settled.size(); k++)
+    {
+        tree->distance[k] = state.distance(settled[k]);
+        tree->parent[k] = state.firstParent(settled[k]);
+    }
+    tree->nodes = std::move(settled);
+    return tree;
+}
+
+// 沿缓存的树从 target 回溯到起点：成功返回 1，不可达返回 -1，前驱断开（不应出现）返回 0
+int backtrackTree(const ShortestPathTree &tree, int target, int maxLength, long &distance, QVector<int> &pathIndices)
+{
+    distance = tree.distanceTo(target);
+    if (distance >= CsrGraph::UNREACHABLE)
+    {
+        distance = CsrGraph::UNREACHABLE;
+        return -1;
+    }
+
+    int current = target;
+    while (current != tree.source && current != 0 && pathIndices.size() < maxLength)
+    {
+        pathIndices.append(current);
+        current = tree.parentOf(current);
+    }
+    if (current != tree.source)
+    {
+        distance = 0;
+        return 0;
+    }
+
+    pathIndices.append(tree.source);
+    std::reverse(pathIndices.begin(), pathIndices.end());
+    return 1;
+}
+
+// 未指定工作区的只读查询使用的线程局部工作区
+QueryWorkspace &threadWorkspace()
+{
+    static thread_local QueryWorkspace workspace;
+    return workspace;
+}
+
+// getDistance 的搜索：重新开始时从起点出发，否则继续上次暂停的搜索
+template <typename Search, typename Queue>
+bool resumeSearch(Search search, Queue &queue, bool restart, int iStart, int iTarget, int &settledCount)
+{
+    if (restart)
+        search.start(queue, iStart);
+    bool finished = search.run(queue, iTarget);
+    settledCount += search.settledCount();
+    return finished;
+}
+
+} // namespace
 
 Dijkstra::Dijkstra()
     : m_nodesCount(0)
     , m_indexStart(0)
+    , m_searchFinished(false)
+    , m_earlyTermination(true)
+    , m_incrementalRepair(false)
+    , m_frozen(false)
+    , m_queueType(QueueAuto)
+    , m_denseThreshold(DEFAULT_DENSE_THRESHOLD)
+    , m_altLandmarkCount(16)
+    , m_altSelection(AltIndex::SelectFarthest)
+    , m_cchCustomized(false)
+    , m_arcFlagRegions(32)
+    , m_deltaThreads(0)
+    , m_matrixMethod(DistanceMatrix::MethodAuto)
+    , m_floydLimit(0)
+    , m_graphVersion(0)
+    , m_queryEngine(EngineDijkstra)
+    , m_settledCount(0)
+    , m_nodeOrder(NodeOrdering::None)
+    , m_orderedNodeCount(0)
 {
     m_nodes.append(NodeInfo());
 }
@@ -100,6 +232,10 @@ bool Dijkstra::loadFileData(const QString &fileName, std::function<void(float)>
 
     file.close();
 
+    // 数据载入完成，构建CSR
+    freeze();
+    setHubLabelFile(fileName + ".hub");
+
     if (progressCallback)
     {
         progressCallback(1.0f);
@@ -111,14 +247,11 @@ bool Dijkstra::loadFileData(const QString &fileName, std::function<void(float)>
 bool Dijkstra::addNodesDist(long idNode1, long idNode2, long distance)
 {
     // 获取或创建节点索引
-    int index1, index2;
+    int index1 = m_idToIndex.value(idNode1);
+    int index2;
 
     // 处理节点1
-    if (m_idToIndex.contains(idNode1))
-    {
-        index1 = m_idToIndex[idNode1];
-    }
-    else
+    if (index1 == 0)
     {
         // 创建新节点
         m_nodesCount++;
@@ -126,15 +259,12 @@ bool Dijkstra::addNodesDist(long idNode1, long idNode2, long distance)
         m_nodes.append(NodeInfo());
         m_nodes[index1].id = idNode1;
         m_nodes[index1].label = QString::number(idNode1); // 默认标签为ID
-        m_idToIndex[idNode1] = index1;
+        m_idToIndex.insert(idNode1, index1);
     }
 
-    // 处理节点2
-    if (m_idToIndex.contains(idNode2))
-    {
-        index2 = m_idToIndex[idNode2];
-    }
-    else
+    // 处理节点2（两端可能是同一节点，节点1刚加入时也要重新查找）
+    index2 = m_idToIndex.value(idNode2);
+    if (index2 == 0)
     {
         // 创建新节点
         m_nodesCount++;
@@ -142,62 +272,121 @@ bool Dijkstra::addNodesDist(long idNode1, long idNode2, long distance)
         m_nodes.append(NodeInfo());
         m_nodes[index2].id = idNode2;
         m_nodes[index2].label = QString::number(idNode2); // 默认标签为ID
-        m_idToIndex[idNode2] = index2;
+        m_idToIndex.insert(idNode2, index2);
     }
 
     // 添加边（双向）
-    if (m_nodes[index1].edges.contains(index2))
+    bool added = false;
+    auto edge1 = m_nodes[index1].edges.constFind(index2);
+    if (edge1 != m_nodes[index1].edges.constEnd())
     {
-        if (m_nodes[index1].edges[index2] != distance)
+        if (edge1.value() != distance)
         {
             m_errorDescription = QString("节点 %1 和节点 %2 之间存在冲突的距离值: %3 和 %4")
                 .arg(idNode1).arg(idNode2)
-                .arg(m_nodes[index1].edges[index2])
+                .arg(edge1.value())
                 .arg(distance);
             return false;
         }
     }
     else
     {
-        m_nodes[index1].edges[index2] = distance;
+        m_nodes[index1].edges.insert(index2, distance);
+        added = true;
     }
 
-    if (m_nodes[index2].edges.contains(index1))
+    auto edge2 = m_nodes[index2].edges.constFind(index1);
+    if (edge2 != m_nodes[index2].edges.constEnd())
     {
-        if (m_nodes[index2].edges[index1] != distance)
+        if (edge2.value() != distance)
         {
             m_errorDescription = QString("节点 %1 和节点 %2 之间存在冲突的距离值: %3 和 %4")
                 .arg(idNode2).arg(idNode1)
-                .arg(m_nodes[index2].edges[index1])
+                .arg(edge2.value())
                 .arg(distance);
             return false;
         }
     }
     else
     {
-        m_nodes[index2].edges[index1] = distance;
+        m_nodes[index2].edges.insert(index1, distance);
+        added = true;
     }
 
-    // 图结构改变，重置计算状态，强制下次重新计算
-    m_indexStart = 0;
+    // 边已存在且距离相同：图没有变化，保留 CSR、搜索结果和各索引
+    if (!added)
+        return true;
+
+    // 图结构改变：增量修复模式下就地修复当前起点的搜索结果，否则重置计算状态，强制下次重新计算
+    if (!repairSearchTree(index1, index2, MAX_DISTANCE, distance))
+        m_indexStart = 0;
+    m_graphVersion++;
+    m_frozen = false;
+    m_alt.clear();
+    m_ch.clear();
+    m_cch.clear();
+    m_hub.clear();
+    m_arcFlags.clear();
+    m_allPairs.close();
+    m_floyd.clear();
+    m_dense.clear();
+
+    return true;
+}
+
+bool Dijkstra::setEdgeDistance(long idNode1, long idNode2, long distance)
+{
+    int index1 = nodeIndex(idNode1);
+    int index2 = nodeIndex(idNode2);
+    if (index1 == 0 || index2 == 0 || !m_nodes[index1].edges.contains(index2))
+    {
+        m_errorDescription = QString("节点 %1 和节点 %2 之间不存在边").arg(idNode1).arg(idNode2);
+        return false;
+    }
+
+    long oldDistance = m_nodes[index1].edges[index2];
+    m_nodes[index1].edges[index2] = distance;
+    m_nodes[index2].edges[index1] = distance;
+
+    // 拓扑不变，CSR 原地更新边权即可保持冻结
+    if (m_frozen)
+    {
+        m_csr.weights[m_csr.findArc(index1, index2)] = distance;
+        m_csr.weights[m_csr.findArc(index2, index1)] = distance;
+        // 只扩大统计范围（被替换的边权可能是原来的极值，范围偏宽不影响正确性）
+        m_csr.minWeight = qMin(m_csr.minWeight, distance);
+        m_csr.maxWeight = qMax(m_csr.maxWeight, distance);
+    }
+
+    if (!repairSearchTree(index1, index2, oldDistance, distance))
+        m_indexStart = 0;
+    m_graphVersion++;
+    m_alt.clear();
+    m_ch.clear();
+    m_cchCustomized = false;
+    m_hub.clear();
+    m_arcFlags.clear();
+    m_allPairs.close();
+    m_floyd.clear();
+    m_dense.clear();
 
     return true;
 }
 
 void Dijkstra::setNodeLabel(long idNode, const QString &label)
 {
-    if (m_idToIndex.contains(idNode))
+    int index = m_idToIndex.value(idNode);
+    if (index != 0)
     {
-        int index = m_idToIndex[idNode];
         m_nodes[index].label = label.isEmpty() ? QString::number(idNode) : label;
     }
 }
 
 QString Dijkstra::getNodeLabel(long idNode) const
 {
-    if (m_idToIndex.contains(idNode))
+    int index = m_idToIndex.value(idNode);
+    if (index != 0)
     {
-        int index = m_idToIndex[idNode];
         return m_nodes[index].label;
     }
     return QString();
@@ -208,19 +397,23 @@ int Dijkstra::getDistance(long idNodeStart, long idNodeEnd, long &distance, QVec
 {
     path.clear();
 
-    if (!m_idToIndex.contains(idNodeStart))
+    // 先冻结：启用节点重排时冻结会重新编号节点
+    if (!m_frozen && m_nodesCount > 0)
+        freeze();
+
+    int iStart = m_idToIndex.value(idNodeStart);
+    if (iStart == 0)
     {
         m_errorDescription = QString("未找到起始节点: %1").arg(idNodeStart);
         return 0;
     }
-    int iStart = m_idToIndex[idNodeStart];
 
-    if (!m_idToIndex.contains(idNodeEnd))
+    int iEnd = m_idToIndex.value(idNodeEnd);
+    if (iEnd == 0)
     {
         m_errorDescription = QString("未找到终止节点: %1").arg(idNodeEnd);
         return 0;
     }
-    int iEnd = m_idToIndex[idNodeEnd];
 
     if (iStart == iEnd)
     {
@@ -231,49 +424,175 @@ int Dijkstra::getDistance(long idNodeStart, long idNodeEnd, long &distance, QVec
         return 1;
     }
 
-    // 计算最短路径
-    if (m_indexStart != iStart)
+    m_settledCount = 0;
+    QVector<int> pathIndices;
+    int result = 0;
+
+    // 小图距离表或已载入的全源距离矩阵可直接查表（动画需要逐个访问节点，有回调时不使用），
+    // 路径无法回溯时再使用查询引擎
+    if (!animCallback)
     {
-        if (!calculate(idNodeStart, animCallback))
-            return 0;
+        if (m_floydLimit > 0 && m_nodesCount <= m_floydLimit)
+            result = queryFloydWarshall(iStart, iEnd, distance, pathIndices);
+        else if (m_allPairs.isLoaded())
+            result = queryAllPairs(iStart, iEnd, distance, pathIndices, animCallback);
     }
 
-    // 从终止节点回溯路径
-    QVector<int> pathIndices;
-    int current = iEnd;
+    // 按选定的查询引擎计算最短路径
+    if (result == 0)
+    {
+        switch (m_queryEngine)
+        {
+        case EngineBidirectional:
+            result = queryBidirectional(iStart, iEnd, distance, pathIndices, animCallback);
+            break;
+        case EngineALT:
+            result = queryAlt(iStart, iEnd, distance, pathIndices, animCallback);
+            break;
+        case EngineCH:
+            result = queryCH(iStart, iEnd, distance, pathIndices, animCallback);
+            break;
+        case EngineCCH:
+            result = queryCCH(iStart, iEnd, distance, pathIndices, animCallback);
+            break;
+        case EngineHubLabels:
+            result = queryHubLabels(iStart, iEnd, distance, pathIndices, animCallback);
+            break;
+        case EngineArcFlags:
+            result = queryArcFlags(iStart, iEnd, distance, pathIndices, animCallback);
+            break;
+        case EngineDeltaStepping:
+            result = queryDeltaStepping(iStart, iEnd, distance, pathIndices, animCallback);
+            break;
+        case EngineDijkstra:
+        default:
+            result = queryDijkstra(iStart, iEnd, distance, pathIndices, animCallback);
+            break;
+        }
 
-    while (current != iStart && pathIndices.size() < m_nodesCount)
+        // 存在负边权时各索引拒绝构建，改用单向 Dijkstra
+        if (result == 0 && m_queryEngine != EngineDijkstra && m_csr.minWeight < 0)
+            result = queryDijkstra(iStart, iEnd, distance, pathIndices, animCallback);
+    }
+
+    if (result <= 0)
+        return result;
+
+    // 构建路径
+    for (int i = 0; i < pathIndices.size(); i++)
     {
-        pathIndices.append(current);
+        path.append(m_nodes[pathIndices[i]].id);
+    }
+    return path.size();
+}
+
+int Dijkstra::query(long idNodeStart, long idNodeEnd, long &distance, QVector<long> &path,
+                    QueryWorkspace *workspace) const
+{
+    path.clear();
+    int iStart = nodeIndex(idNodeStart);
+    int iEnd = nodeIndex(idNodeEnd);
+    if (iStart == 0 || iEnd == 0 || !m_frozen)
+        return 0;
+
+    if (iStart == iEnd)
+    {
+        distance = 0;
+        path.append(idNodeStart);
+        return 1;
+    }
 
-        if (m_nodes[current].parents.isEmpty())
+    // 已算好的距离表或全源距离矩阵直接查表，路径无法回溯时再搜索
+    if (!m_floyd.isEmpty() || m_allPairs.isLoaded())
+    {
+        QVector<int> pathIndices;
+        int result = !m_floyd.isEmpty() ? lookupFloydWarshall(iStart, iEnd, distance, pathIndices)
+                                        : queryAllPairs(iStart, iEnd, distance, pathIndices, nullptr);
+        if (result < 0)
+            return result;
+        if (result > 0)
         {
-            distance = MAX_DISTANCE;
-            return -1;
+            for (int i = 0; i < pathIndices.size(); i++)
+                path.append(m_nodes[pathIndices[i]].id);
+            return path.size();
         }
+    }
 
-        current = m_nodes[current].parents.first();
+    QueryWorkspace &work = workspace ? *workspace : threadWorkspace();
+    QueueType queueType = effectiveQueueType();
+
+    // 先查最短路径树缓存（可能由 getDistance 或其他线程的查询写入）
+    bool useCache = m_treeCache.budget() > 0;
+    if (useCache)
+    {
+        QSharedPointer<const ShortestPathTree> tree = m_treeCache.find(iStart, m_graphVersion, iEnd);
+        if (tree)
+        {
+            QVector<int> pathIndices;
+            int result = backtrackTree(*tree, iEnd, m_nodesCount, distance, pathIndices);
+            for (int i = 0; i < pathIndices.size(); i++)
+                path.append(m_nodes[pathIndices[i]].id);
+            return result > 0 ? path.size() : result;
+        }
     }
 
-    if (current != iStart)
+    CompactSearchWorkspace<long, int, true> &state = work.state;
+    state.resize(m_nodesCount);
+    state.reset();
+    if (useCache)
     {
-        m_errorDescription = "无法回溯到起始节点";
-        distance = 0;
-        return 0;
+        work.settled.resize(0);
+        bool finished = searchTarget(RecordedPathSearch(csrView(m_csr), state, SettledRecorder(&work.settled)),
+                                     m_csr, queueType, work, iStart, iEnd);
+        m_treeCache.insert(makeSearchTree(iStart, m_graphVersion, finished, m_nodesCount, work.settled, state));
+    }
+    else
+    {
+        searchTarget(PathSearch(csrView(m_csr), state), m_csr, queueType, work, iStart, iEnd);
     }
 
-    // 构建路径
-    path.append(idNodeStart);
-    for (int i = pathIndices.size() - 1; i >= 0; i--)
+    if (!state.visited(iEnd))
     {
-        path.append(m_nodes[pathIndices[i]].id);
+        distance = MAX_DISTANCE;
+        return -1;
     }
 
-    distance = m_nodes[iEnd].distance;
+    for (int current = iEnd; current != 0; current = state.firstParent(current))
+        path.append(m_nodes[current].id);
+    std::reverse(path.begin(), path.end());
+    distance = state.distance(iEnd);
     return path.size();
 }
 
-bool Dijkstra::calculate(long idNodeStart, AnimationCallback animCallback)
+int Dijkstra::queryDistance(long idNodeStart, long idNodeEnd, long &distance, QueryWorkspace *workspace) const
+{
+    int iStart = nodeIndex(idNodeStart);
+    int iEnd = nodeIndex(idNodeEnd);
+    if (iStart == 0 || iEnd == 0 || !m_frozen)
+        return 0;
+
+    if (iStart == iEnd)
+    {
+        distance = 0;
+        return 1;
+    }
+
+    QueryWorkspace &work = workspace ? *workspace : threadWorkspace();
+    CompactSearchWorkspace<long, int, false> &state = work.distanceState;
+    state.resize(m_nodesCount);
+    state.reset();
+    searchTarget(DistanceSearch(csrView(m_csr), state), m_csr, effectiveQueueType(), work, iStart, iEnd);
+
+    if (!state.visited(iEnd))
+    {
+        distance = MAX_DISTANCE;
+        return -1;
+    }
+    distance = state.distance(iEnd);
+    return 1;
+}
+
+bool Dijkstra::buildAllPairs(const QString &fileName, int threadCount, int rowLimit)
 {
     if (m_nodesCount == 0)
     {
@@ -281,121 +600,1271 @@ bool Dijkstra::calculate(long idNodeStart, AnimationCallback animCallback)
         return false;
     }
 
-    if (!m_idToIndex.contains(idNodeStart))
+    if (!m_frozen)
+        freeze();
+
+    // 构建时以读写方式打开同一文件，先关闭已载入的矩阵
+    m_allPairs.close();
+    AllPairsMatrix matrix;
+    if (!matrix.build(m_csr, fileName, threadCount, rowLimit))
     {
-        m_errorDescription = QString("未找到起始节点: %1").arg(idNodeStart);
+        m_errorDescription = QString("无法写入距离矩阵文件: %1").arg(fileName);
         return false;
     }
-    int iStart = m_idToIndex[idNodeStart];
-    
-    // 如果起始节点改变或图结构改变，重置计算状态
-    if (m_indexStart != iStart)
+    return true;
+}
+
+bool Dijkstra::loadAllPairs(const QString &fileName)
+{
+    if (!m_frozen)
+        freeze();
+
+    if (!m_allPairs.load(fileName, m_csr))
     {
-        m_indexStart = 0; // 强制重新计算
+        m_errorDescription = QString("距离矩阵文件无效、未完成或与当前图不一致: %1").arg(fileName);
+        return false;
     }
+    return true;
+}
 
-    // 初始化所有节点
-    for (int i = 1; i <= m_nodesCount; i++)
+int Dijkstra::queryAllPairs(int iStart, int iEnd, long &distance, QVector<int> &pathIndices,
+                            const AnimationCallback &animCallback) const
+{
+    distance = m_allPairs.distance(iStart, iEnd);
+    if (distance >= MAX_DISTANCE)
     {
-        m_nodes[i].distance = MAX_DISTANCE;
-        m_nodes[i].visited = false;
-        m_nodes[i].parents.clear();
+        distance = MAX_DISTANCE;
+        return -1;
+    }
+    if (!m_allPairs.path(m_csr, iStart, iEnd, pathIndices))
+    {
+        pathIndices.clear();
+        return 0;
     }
 
-    // 设置起始节点
-    m_nodes[iStart].visited = true;
-    m_nodes[iStart].distance = 0;
     if (animCallback)
-        animCallback(iStart, 0, false);
+        animCallback(iStart, 0, true);
+    return 1;
+}
+
+void Dijkstra::setFloydWarshallLimit(int maxNodes)
+{
+    m_floydLimit = maxNodes;
+    if (m_floydLimit <= 0 || m_nodesCount > m_floydLimit)
+        m_floyd.clear();
+}
 
-    // 初始化起始节点的邻接节点
-    QList<int> unvisitedNodes;
-    for (auto it = m_nodes[iStart].edges.begin(); it != m_nodes[iStart].edges.end(); ++it)
+bool Dijkstra::buildFloydWarshall(FloydWarshall::Kernel kernel)
+{
+    if (m_nodesCount == 0)
     {
-        int adjIndex = it.key();
-        long edgeDist = it.value();
-        m_nodes[adjIndex].distance = edgeDist;
-        m_nodes[adjIndex].parents.append(iStart);
-        unvisitedNodes.append(adjIndex);
-        if (animCallback)
-            animCallback(adjIndex, edgeDist, false);
+        m_errorDescription = "没有节点数据";
+        return false;
+    }
+
+    if (!m_frozen)
+        freeze();
+
+    if (!m_floyd.build(m_csr, kernel))
+    {
+        m_errorDescription = "边权为负或距离超出 32 位范围，无法建立距离表";
+        return false;
     }
+    return true;
+}
+
+int Dijkstra::queryFloydWarshall(int iStart, int iEnd, long &distance, QVector<int> &pathIndices)
+{
+    if (m_floyd.isEmpty() && !buildFloydWarshall())
+        return 0;
+    return lookupFloydWarshall(iStart, iEnd, distance, pathIndices);
+}
 
-    // Dijkstra主循环
-    while (!unvisitedNodes.isEmpty())
+int Dijkstra::lookupFloydWarshall(int iStart, int iEnd, long &distance, QVector<int> &pathIndices) const
+{
+    distance = m_floyd.distance(iStart, iEnd);
+    if (distance >= MAX_DISTANCE)
     {
-        // 找到未访问节点中距离最小的
-        int minIndex = -1;
-        long minDist = MAX_DISTANCE;
-        int minPos = -1;
+        distance = MAX_DISTANCE;
+        return -1;
+    }
+    return m_floyd.path(iStart, iEnd, pathIndices) ? 1 : 0;
+}
+
+bool Dijkstra::distanceMatrix(const QVector<long> &sources, const QVector<long> &targets, QVector<long> &distances,
+                              const QVector<QPair<int, int>> &pathPairs, QVector<QVector<long>> *paths,
+                              int threadCount)
+{
+    distances.clear();
+    if (paths)
+        paths->clear();
+
+    // 冻结可能重排节点，先冻结再取索引
+    if (!m_frozen)
+        freeze();
 
-        for (int i = 0; i < unvisitedNodes.size(); i++)
+    QVector<int> sourceIndices, targetIndices;
+    for (int i = 0; i < sources.size(); i++)
+    {
+        int index = nodeIndex(sources[i]);
+        if (index == 0)
         {
-            int idx = unvisitedNodes[i];
-            if (!m_nodes[idx].visited && m_nodes[idx].distance < minDist)
-            {
-                minDist = m_nodes[idx].distance;
-                minIndex = idx;
-                minPos = i;
-            }
+            m_errorDescription = QString("未找到起始节点: %1").arg(sources[i]);
+            return false;
         }
+        sourceIndices.append(index);
+    }
+    for (int j = 0; j < targets.size(); j++)
+    {
+        int index = nodeIndex(targets[j]);
+        if (index == 0)
+        {
+            m_errorDescription = QString("未找到终止节点: %1").arg(targets[j]);
+            return false;
+        }
+        targetIndices.append(index);
+    }
 
-        if (minIndex == -1)
-            break;
-
-        // 标记为已访问
-        m_nodes[minIndex].visited = true;
-        unvisitedNodes.removeAt(minPos);
-        if (animCallback)
-            animCallback(minIndex, m_nodes[minIndex].distance, false);
+    DistanceMatrix matrix;
+    matrix.setMethod(m_matrixMethod);
+    if (!matrix.compute(m_csr, sourceIndices, targetIndices, pathPairs, threadCount))
+    {
+        m_errorDescription = "路径请求的行或列超出范围";
+        return false;
+    }
+    distances = matrix.distances();
 
-        // 更新邻接节点
-        for (auto it = m_nodes[minIndex].edges.begin(); it != m_nodes[minIndex].edges.end(); ++it)
+    if (paths)
+    {
+        paths->resize(pathPairs.size());
+        for (int k = 0; k < pathPairs.size(); k++)
         {
-            int adjIndex = it.key();
-            long edgeDist = it.value();
+            const QVector<int> &pathIndices = matrix.path(k);
+            for (int i = 0; i < pathIndices.size(); i++)
+                (*paths)[k].append(m_nodes[pathIndices[i]].id);
+        }
+    }
+    return true;
+}
 
-            if (m_nodes[adjIndex].visited)
-                continue;
+int Dijkstra::queryDijkstra(int iStart, int iEnd, long &distance, QVector<int> &pathIndices,
+                            const AnimationCallback &animCallback)
+{
+    // 其他起点先查最短路径树缓存（动画需要重新搜索）
+    if (m_indexStart != iStart && !animCallback && m_treeCache.budget() > 0)
+    {
+        QSharedPointer<const ShortestPathTree> tree = m_treeCache.find(iStart, m_graphVersion, iEnd);
+        if (tree)
+            return queryTree(*tree, iEnd, distance, pathIndices);
+    }
 
-            long newDist = m_nodes[minIndex].distance + edgeDist;
+    // 计算最短路径
+    // 同一起点的已确定节点可直接复用；点对点模式下终点确定后即停止搜索
+    if (m_indexStart != iStart || (!m_searchFinished && !m_work.visited(iEnd)))
+    {
+        if (!calculate(m_nodes[iStart].id, animCallback, m_earlyTermination ? iEnd : 0))
+            return 0;
+    }
 
-            if (newDist < m_nodes[adjIndex].distance)
-            {
-                m_nodes[adjIndex].distance = newDist;
-                m_nodes[adjIndex].parents.clear();
-                m_nodes[adjIndex].parents.append(minIndex);
-
-                if (!unvisitedNodes.contains(adjIndex))
-                    unvisitedNodes.append(adjIndex);
-                
-                if (animCallback)
-                    animCallback(adjIndex, newDist, false);
-            }
-            else if (newDist == m_nodes[adjIndex].distance)
-            {
-                if (!m_nodes[adjIndex].parents.contains(minIndex))
-                    m_nodes[adjIndex].parents.append(minIndex);
-            }
+    // 从终止节点回溯路径
+    int current = iEnd;
+
+    while (current != iStart && pathIndices.size() < m_nodesCount)
+    {
+        pathIndices.append(current);
+
+        int parent = m_work.firstParent(current);
+        if (parent == 0)
+        {
+            distance = MAX_DISTANCE;
+            return -1;
         }
+
+        current = parent;
     }
 
-    m_indexStart = iStart;
-    if (animCallback)
-        animCallback(iStart, 0, true);
+    if (current != iStart)
+    {
+        m_errorDescription = "无法回溯到起始节点";
+        distance = 0;
+        return 0;
+    }
+
+    pathIndices.append(iStart);
+    std::reverse(pathIndices.begin(), pathIndices.end());
+
+    distance = m_work.distance(iEnd);
+    return 1;
+}
+
+int Dijkstra::queryTree(const ShortestPathTree &tree, int iEnd, long &distance, QVector<int> &pathIndices)
+{
+    int result = backtrackTree(tree, iEnd, m_nodesCount, distance, pathIndices);
+    if (result == 0)
+        m_errorDescription = "无法回溯到起始节点";
+    return result;
+}
+
+void Dijkstra::cacheSearchTree()
+{
+    if (m_indexStart == 0 || m_treeCache.budget() <= 0)
+        return;
+    // 同一起点的搜索按距离顺序确定节点，后一次的结果总包含前一次，只有已缓存完整的树时不必替换
+    if (m_treeCache.containsComplete(m_indexStart, m_graphVersion))
+        return;
+
+    // 只遍历本次搜索触及的节点，提前终止的搜索按稀疏方式存放
+    QVector<int> settled;
+    const QVector<int> &touched = m_work.touchedNodes();
+    for (int i = 0; i < touched.size(); i++)
+    {
+        if (m_work.visited(touched[i]))
+            settled.append(touched[i]);
+    }
+    m_treeCache.insert(makeSearchTree(m_indexStart, m_graphVersion, m_searchFinished, m_nodesCount,
+                                      settled, m_work));
+}
+
+bool Dijkstra::repairSearchTree(int index1, int index2, long oldWeight, long newWeight)
+{
+    // 只修复完整的最短路径树；负边权下按距离顺序修复不成立
+    if (!m_incrementalRepair || m_indexStart == 0 || !m_searchFinished || newWeight < 0 || m_csr.minWeight < 0)
+        return false;
+
+    m_work.resize(m_nodesCount);
+    if (newWeight < oldWeight)
+        repairDecrease(index1, index2, newWeight);
+    else if (newWeight > oldWeight)
+        repairIncrease(index1, index2);
     return true;
 }
 
-int Dijkstra::nodeCount() const
+void Dijkstra::relaxRepair(int u, int v, long weight)
 {
-    return m_nodesCount;
+    long du = m_work.distance(u);
+    if (du >= MAX_DISTANCE)
+        return;
+
+    long newDist = du + weight;
+    SearchWorkspace::Entry &target = m_work.entry(v);
+    if (newDist < target.distance)
+    {
+        target.distance = newDist;
+        target.visited = true;
+        target.parents.clear();
+        target.parents.append(u);
+        m_lazyHeap.push(v, newDist);
+    }
+    else if (newDist == target.distance && weight > 0 && !target.parents.contains(u))
+    {
+        // 零权边的等距前驱可能成环，只追加正权边的前驱
+        target.parents.append(u);
+    }
 }
 
-int Dijkstra::nodeIndex(long idNode) const
+void Dijkstra::repairDecrease(int index1, int index2, long weight)
 {
-    if (m_idToIndex.contains(idNode))
-        return m_idToIndex[idNode];
-    return 0;
+    // 距离只会变小：从新边的两端开始，按距离顺序只松弛距离变小的节点
+    m_lazyHeap.reset(m_nodesCount);
+    relaxRepair(index1, index2, weight);
+    relaxRepair(index2, index1, weight);
+
+    while (!m_lazyHeap.isEmpty())
+    {
+        long minDist;
+        int u = m_lazyHeap.pop(minDist);
+        if (minDist != m_work.distance(u))
+            continue;   // 过期条目
+
+        const QMap<int, long> &edges = m_nodes[u].edges;
+        for (auto it = edges.constBegin(); it != edges.constEnd(); ++it)
+            relaxRepair(u, it.key(), it.value());
+    }
+}
+
+void Dijkstra::repairIncrease(int index1, int index2)
+{
+    // 第一步：边原来是最短路径上的边时，从终点的前驱中删除另一端；前驱全部失去的节点距离可能变大，
+    // 先置为不可达，它的后继再依次删除该前驱，得到受影响的节点集合
+    QVector<int> affected;
+    auto detach = [this, &affected](int parent, int child) {
+        if (child == m_indexStart || !m_work.isTouched(child))
+            return;
+        SearchWorkspace::Entry &entry = m_work.entry(child);
+        if (entry.parents.removeAll(parent) > 0 && entry.parents.isEmpty())
+        {
+            entry.distance = MAX_DISTANCE;
+            entry.visited = false;
+            affected.append(child);
+        }
+    };
+    detach(index1, index2);
+    detach(index2, index1);
+    for (int i = 0; i < affected.size(); i++)
+    {
+        int u = affected[i];
+        const QMap<int, long> &edges = m_nodes[u].edges;
+        for (auto it = edges.constBegin(); it != edges.constEnd(); ++it)
+            detach(u, it.key());
+    }
+
+    // 第二步：受影响节点的距离先取经邻居的最小值（受影响的邻居此时不可达，不参与）
+    m_lazyHeap.reset(m_nodesCount);
+    for (int i = 0; i < affected.size(); i++)
+    {
+        int u = affected[i];
+        const QMap<int, long> &edges = m_nodes[u].edges;
+        for (auto it = edges.constBegin(); it != edges.constEnd(); ++it)
+            relaxRepair(it.key(), u, it.value());
+    }
+
+    // 第三步：按距离顺序继续 Dijkstra；未受影响节点的距离不会变小，只会补充等距前驱
+    while (!m_lazyHeap.isEmpty())
+    {
+        long minDist;
+        int u = m_lazyHeap.pop(minDist);
+        if (minDist != m_work.distance(u))
+            continue;
+
+        const QMap<int, long> &edges = m_nodes[u].edges;
+        for (auto it = edges.constBegin(); it != edges.constEnd(); ++it)
+            relaxRepair(u, it.key(), it.value());
+    }
+}
+
+void Dijkstra::SearchSide::reset(int nodeCount)
+{
+    if (distance.size() != nodeCount + 1)
+    {
+        distance.fill(MAX_DISTANCE, nodeCount + 1);
+        parent.fill(0, nodeCount + 1);
+        settled.fill(false, nodeCount + 1);
+    }
+    else
+    {
+        for (int i = 0; i < touched.size(); i++)
+        {
+            int node = touched[i];
+            distance[node] = MAX_DISTANCE;
+            parent[node] = 0;
+            settled[node] = false;
+        }
+    }
+    touched.clear();
+    heap.reset(nodeCount);
+}
+
+int Dijkstra::queryBidirectional(int iStart, int iEnd, long &distance, QVector<int> &pathIndices,
+                                 const AnimationCallback &animCallback)
+{
+    if (!m_frozen)
+        freeze();
+
+    const int *offsets = m_csr.offsets.constData();
+    const int *targets = m_csr.targets.constData();
+    const long *weights = m_csr.weights.constData();
+
+    const int roots[2] = { iStart, iEnd };
+    for (int d = 0; d < 2; d++)
+    {
+        SearchSide &side = m_sides[d];
+        side.reset(m_nodesCount);
+        side.distance[roots[d]] = 0;
+        side.touched.append(roots[d]);
+        side.heap.push(roots[d], 0);
+    }
+
+    // best：目前找到的最短 起点->终点 距离，经由边 (meetFrom, meetTo)
+    long best = MAX_DISTANCE;
+    int meetFrom = 0, meetTo = 0;
+
+    while (!m_sides[0].heap.isEmpty() && !m_sides[1].heap.isEmpty())
+    {
+        // 停止条件：两侧队首距离之和不小于当前最优值
+        if (m_sides[0].heap.topKey() + m_sides[1].heap.topKey() >= best)
+            break;
+
+        // 每次扩展队列较小的一侧
+        int d = (m_sides[0].heap.size() <= m_sides[1].heap.size()) ? 0 : 1;
+        SearchSide &side = m_sides[d];
+        const SearchSide &other = m_sides[1 - d];
+
+        long minDist;
+        int minIndex = side.heap.pop(minDist);
+        side.settled[minIndex] = true;
+        m_settledCount++;
+        if (animCallback)
+            animCallback(minIndex, minDist, false);
+
+        for (int e = offsets[minIndex]; e < offsets[minIndex + 1]; e++)
+        {
+            int adjIndex = targets[e];
+            long newDist = minDist + weights[e];
+
+            // 邻接节点已被另一侧到达，更新候选最短路径
+            if (other.distance[adjIndex] < MAX_DISTANCE)
+            {
+                long total = newDist + other.distance[adjIndex];
+                if (total < best)
+                {
+                    best = total;
+                    meetFrom = (d == 0) ? minIndex : adjIndex;
+                    meetTo = (d == 0) ? adjIndex : minIndex;
+                }
+            }
+
+            if (side.settled[adjIndex])
+                continue;
+
+            if (newDist < side.distance[adjIndex])
+            {
+                if (side.distance[adjIndex] == MAX_DISTANCE)
+                    side.touched.append(adjIndex);
+                side.distance[adjIndex] = newDist;
+                side.parent[adjIndex] = minIndex;
+                side.heap.push(adjIndex, newDist);
+            }
+        }
+    }
+
+    if (animCallback)
+        animCallback(iStart, 0, true);
+
+    if (best >= MAX_DISTANCE)
+    {
+        distance = MAX_DISTANCE;
+        return -1;
+    }
+
+    // 正向部分：meetFrom 回溯到起点
+    for (int node = meetFrom; node != iStart; node = m_sides[0].parent[node])
+        pathIndices.append(node);
+    pathIndices.append(iStart);
+    std::reverse(pathIndices.begin(), pathIndices.end());
+
+    // 反向部分：meetTo 沿反向父节点走到终点
+    for (int node = meetTo; node != iEnd; node = m_sides[1].parent[node])
+        pathIndices.append(node);
+    pathIndices.append(iEnd);
+
+    distance = best;
+    return 1;
+}
+
+int Dijkstra::queryAlt(int iStart, int iEnd, long &distance, QVector<int> &pathIndices,
+                       const AnimationCallback &animCallback)
+{
+    if (!m_frozen)
+        freeze();
+    if (m_alt.isEmpty() && !buildLandmarks(m_altLandmarkCount, m_altSelection))
+        return 0;
+
+    // 地标下界可判定不连通时无需搜索
+    if (m_alt.lowerBound(iStart, iEnd) >= MAX_DISTANCE)
+    {
+        if (animCallback)
+            animCallback(iStart, 0, true);
+        distance = MAX_DISTANCE;
+        return -1;
+    }
+
+    const int *offsets = m_csr.offsets.constData();
+    const int *targets = m_csr.targets.constData();
+    const long *weights = m_csr.weights.constData();
+
+    // A*：队列键值为 距离 + 到终点的下界，下界一致，终点出队即为最短
+    SearchSide &side = m_sides[0];
+    side.reset(m_nodesCount);
+    side.distance[iStart] = 0;
+    side.touched.append(iStart);
+    side.heap.push(iStart, m_alt.lowerBound(iStart, iEnd));
+
+    bool found = false;
+    while (!side.heap.isEmpty())
+    {
+        long key;
+        int minIndex = side.heap.pop(key);
+        long minDist = side.distance[minIndex];
+        side.settled[minIndex] = true;
+        m_settledCount++;
+        if (animCallback)
+            animCallback(minIndex, minDist, false);
+
+        if (minIndex == iEnd)
+        {
+            found = true;
+            break;
+        }
+
+        for (int e = offsets[minIndex]; e < offsets[minIndex + 1]; e++)
+        {
+            int adjIndex = targets[e];
+            if (side.settled[adjIndex])
+                continue;
+
+            long newDist = minDist + weights[e];
+            if (newDist < side.distance[adjIndex])
+            {
+                if (side.distance[adjIndex] == MAX_DISTANCE)
+                    side.touched.append(adjIndex);
+                side.distance[adjIndex] = newDist;
+                side.parent[adjIndex] = minIndex;
+                side.heap.push(adjIndex, newDist + m_alt.lowerBound(adjIndex, iEnd));
+            }
+        }
+    }
+
+    if (animCallback)
+        animCallback(iStart, 0, true);
+
+    if (!found)
+    {
+        distance = MAX_DISTANCE;
+        return -1;
+    }
+
+    for (int node = iEnd; node != iStart; node = side.parent[node])
+        pathIndices.append(node);
+    pathIndices.append(iStart);
+    std::reverse(pathIndices.begin(), pathIndices.end());
+
+    distance = side.distance[iEnd];
+    return 1;
+}
+
+int Dijkstra::queryCH(int iStart, int iEnd, long &distance, QVector<int> &pathIndices,
+                      const AnimationCallback &animCallback)
+{
+    if (!m_frozen)
+        freeze();
+    if (m_ch.isEmpty() && !buildContractionHierarchy())
+        return 0;
+
+    // 向上图中的搜索节点不对应原图的搜索顺序，只报告完成
+    distance = m_ch.query(iStart, iEnd, &pathIndices, &m_settledCount);
+
+    if (animCallback)
+        animCallback(iStart, 0, true);
+
+    if (distance >= MAX_DISTANCE)
+    {
+        distance = MAX_DISTANCE;
+        return -1;
+    }
+    return 1;
+}
+
+int Dijkstra::queryCCH(int iStart, int iEnd, long &distance, QVector<int> &pathIndices,
+                       const AnimationCallback &animCallback)
+{
+    if (m_cch.isEmpty())
+    {
+        if (!buildCustomizableCH())
+            return 0;
+    }
+    else if (!m_cchCustomized && !customizeCH())
+    {
+        return 0;
+    }
+
+    distance = m_cch.query(iStart, iEnd, &pathIndices, &m_settledCount);
+
+    if (animCallback)
+        animCallback(iStart, 0, true);
+
+    if (distance >= MAX_DISTANCE)
+    {
+        distance = MAX_DISTANCE;
+        return -1;
+    }
+    return 1;
+}
+
+int Dijkstra::queryHubLabels(int iStart, int iEnd, long &distance, QVector<int> &pathIndices,
+                             const AnimationCallback &animCallback)
+{
+    if (m_hub.isEmpty())
+    {
+        if (!m_frozen)
+            freeze();
+        bool loaded = !m_hubLabelFile.isEmpty() && m_hub.load(m_hubLabelFile, m_csr);
+        if (!loaded)
+        {
+            if (!buildHubLabels())
+                return 0;
+            if (!m_hubLabelFile.isEmpty())
+                m_hub.save(m_hubLabelFile, m_csr);
+        }
+    }
+
+    distance = m_hub.query(iStart, iEnd, &pathIndices);
+    m_settledCount = 0;
+
+    if (animCallback)
+        animCallback(iStart, 0, true);
+
+    if (distance >= MAX_DISTANCE)
+    {
+        distance = MAX_DISTANCE;
+        return -1;
+    }
+    return 1;
+}
+
+int Dijkstra::queryArcFlags(int iStart, int iEnd, long &distance, QVector<int> &pathIndices,
+                            const AnimationCallback &animCallback)
+{
+    if (!m_frozen)
+        freeze();
+    if (m_arcFlags.isEmpty() && !buildArcFlags(m_arcFlagRegions))
+        return 0;
+
+    const int *offsets = m_csr.offsets.constData();
+    const int *targets = m_csr.targets.constData();
+    const long *weights = m_csr.weights.constData();
+    const quint64 *flags = m_arcFlags.flags(m_arcFlags.region(iEnd));
+
+    // 只沿目标区域标志位为 1 的边扩展的 Dijkstra
+    SearchSide &side = m_sides[0];
+    side.reset(m_nodesCount);
+    side.distance[iStart] = 0;
+    side.touched.append(iStart);
+    side.heap.push(iStart, 0);
+
+    bool found = false;
+    while (!side.heap.isEmpty())
+    {
+        long minDist;
+        int minIndex = side.heap.pop(minDist);
+        side.settled[minIndex] = true;
+        m_settledCount++;
+        if (animCallback)
+            animCallback(minIndex, minDist, false);
+
+        if (minIndex == iEnd)
+        {
+            found = true;
+            break;
+        }
+
+        for (int e = offsets[minIndex]; e < offsets[minIndex + 1]; e++)
+        {
+            if (!ArcFlags::isSet(flags, e))
+                continue;
+            int adjIndex = targets[e];
+            if (side.settled[adjIndex])
+                continue;
+
+            long newDist = minDist + weights[e];
+            if (newDist < side.distance[adjIndex])
+            {
+                if (side.distance[adjIndex] == MAX_DISTANCE)
+                    side.touched.append(adjIndex);
+                side.distance[adjIndex] = newDist;
+                side.parent[adjIndex] = minIndex;
+                side.heap.push(adjIndex, newDist);
+            }
+        }
+    }
+
+    if (animCallback)
+        animCallback(iStart, 0, true);
+
+    if (!found)
+    {
+        distance = MAX_DISTANCE;
+        return -1;
+    }
+
+    for (int node = iEnd; node != iStart; node = side.parent[node])
+        pathIndices.append(node);
+    pathIndices.append(iStart);
+    std::reverse(pathIndices.begin(), pathIndices.end());
+
+    distance = side.distance[iEnd];
+    return 1;
+}
+
+int Dijkstra::queryDeltaStepping(int iStart, int iEnd, long &distance, QVector<int> &pathIndices,
+                                 const AnimationCallback &animCallback)
+{
+    // 完整结果写入搜索状态后与单向 Dijkstra 共用路径回溯
+    if (m_indexStart != iStart || !m_searchFinished)
+    {
+        if (!calculateDeltaStepping(m_nodes[iStart].id, m_deltaThreads))
+            return 0;
+        if (animCallback)
+            animCallback(iStart, 0, true);
+    }
+    return queryDijkstra(iStart, iEnd, distance, pathIndices, animCallback);
+}
+
+bool Dijkstra::calculateDeltaStepping(long idNodeStart, int threadCount, long delta)
+{
+    if (m_nodesCount == 0)
+    {
+        m_errorDescription = "没有节点数据";
+        return false;
+    }
+
+    if (!m_frozen)
+        freeze();
+
+    int iStart = nodeIndex(idNodeStart);
+    if (iStart == 0)
+    {
+        m_errorDescription = QString("未找到起始节点: %1").arg(idNodeStart);
+        return false;
+    }
+
+    if (m_indexStart != iStart)
+        cacheSearchTree();
+
+    if (!m_delta.run(m_csr, iStart, threadCount, delta))
+    {
+        m_errorDescription = "delta-stepping 不支持负边权";
+        return false;
+    }
+
+    // 按线程切分节点，写入距离、访问标记和全部前驱（各节点互不影响）
+    if (threadCount <= 0)
+        threadCount = QThread::idealThreadCount();
+    m_work.resize(m_nodesCount);
+    m_work.reset();
+    m_work.touchAll();
+    SearchWorkspace::Entry *nodes = m_work.rawEntries();
+    const CsrGraph &graph = m_csr;
+    const DeltaStepping &result = m_delta;
+    int n = m_nodesCount;
+    QVector<int> workers;
+    for (int w = 0; w < threadCount; w++)
+        workers.append(w);
+    QtConcurrent::blockingMap(workers, [nodes, &graph, &result, n, threadCount](int worker) {
+        int first = int(qint64(n) * worker / threadCount) + 1;
+        int last = int(qint64(n) * (worker + 1) / threadCount);
+        for (int v = first; v <= last; v++)
+        {
+            nodes[v].distance = result.distance(v);
+            nodes[v].visited = result.distance(v) < MAX_DISTANCE;
+            result.parents(graph, v, nodes[v].parents);
+        }
+    });
+
+    m_settledCount = 0;
+    for (int v = 1; v <= n; v++)
+    {
+        if (nodes[v].visited)
+            m_settledCount++;
+    }
+
+    m_indexStart = iStart;
+    m_searchFinished = true;
+    return true;
+}
+
+bool Dijkstra::calculate(long idNodeStart, AnimationCallback animCallback, int iTarget)
+{
+    if (m_nodesCount == 0)
+    {
+        m_errorDescription = "没有节点数据";
+        return false;
+    }
+
+    if (!m_frozen)
+        freeze();
+
+    int iStart = m_idToIndex.value(idNodeStart);
+    if (iStart == 0)
+    {
+        m_errorDescription = QString("未找到起始节点: %1").arg(idNodeStart);
+        return false;
+    }
+
+    // 起始节点改变或图结构改变时重新开始搜索，否则继续上次未完成的搜索
+    bool restart = (m_indexStart != iStart);
+    if (restart)
+    {
+        cacheSearchTree();
+
+        // 递增代号即复位所有节点，不逐个写入
+        m_work.resize(m_nodesCount);
+        m_work.reset();
+        m_indexStart = iStart;
+    }
+
+    // 按选定的优先队列执行搜索
+    switch (effectiveQueueType())
+    {
+    case QueueLinearScan:
+        m_searchFinished = runSearch(m_scanQueue, restart, iStart, iTarget, animCallback);
+        break;
+    case QueueLazyBinaryHeap:
+        m_searchFinished = runSearch(m_lazyHeap, restart, iStart, iTarget, animCallback);
+        break;
+    case QueueDialBuckets:
+        if (restart)
+            m_dialQueue.setMaxWeight(m_csr.maxWeight);
+        m_searchFinished = runSearch(m_dialQueue, restart, iStart, iTarget, animCallback);
+        break;
+    case QueueRadixHeap:
+        m_searchFinished = runSearch(m_radixHeap, restart, iStart, iTarget, animCallback);
+        break;
+    case QueueBfs:
+        m_searchFinished = runSearch(m_fifoQueue, restart, iStart, iTarget, animCallback);
+        break;
+    case QueueDenseMatrix:
+        if (m_dense.isEmpty())
+            m_dense.build(m_csr);
+        m_searchFinished = runDenseSearch(restart, iStart, iTarget, animCallback);
+        break;
+    case QueueDaryHeap:
+    default:
+        m_searchFinished = runSearch(m_daryHeap, restart, iStart, iTarget, animCallback);
+        break;
+    }
+
+    if (animCallback)
+        animCallback(iStart, 0, true);
+    return true;
+}
+
+template <typename Queue>
+bool Dijkstra::runSearch(Queue &queue, bool restart, int iStart, int iTarget,
+                         const AnimationCallback &animCallback)
+{
+    // 没有动画时使用空观察者，主循环中不再逐次判断回调
+    if (animCallback)
+        return resumeSearch(AnimatedTreeSearch(csrView(m_csr), m_work, AnimationObserver(animCallback)),
+                            queue, restart, iStart, iTarget, m_settledCount);
+    return resumeSearch(TreeSearch(csrView(m_csr), m_work), queue, restart, iStart, iTarget, m_settledCount);
+}
+
+bool Dijkstra::runDenseSearch(bool restart, int iStart, int iTarget, const AnimationCallback &animCallback)
+{
+    if (restart)
+    {
+        m_dense.reset(iStart);
+        m_work.entry(iStart).distance = 0;
+    }
+
+    QVector<int> improved;
+    long minDist;
+    int minIndex;
+    while ((minIndex = m_dense.settleNext(minDist)) != 0)
+    {
+        SearchWorkspace::Entry &node = m_work.entry(minIndex);
+        node.visited = true;
+        node.distance = minDist;
+        // 只记录矩阵搜索树中的前驱：回溯只用第一个前驱，逐条检查等距邻居的 O(E) 开销会抵消矩阵扫描的收益
+        if (minIndex != iStart)
+            node.parents.append(m_dense.parent(minIndex));
+        m_settledCount++;
+        if (animCallback)
+            animCallback(minIndex, minDist, false);
+
+        // 只有动画需要逐个得到距离变小的节点
+        m_dense.relax(minIndex, animCallback ? &improved : nullptr);
+        for (int i = 0; i < improved.size(); i++)
+            animCallback(improved[i], m_dense.distance(improved[i]), false);
+        improved.clear();
+
+        if (minIndex == iTarget)
+            return false;
+    }
+    return true;
+}
+
+void Dijkstra::freeze()
+{
+    if (m_frozen)
+        return;
+
+    buildCsr();
+    m_frozen = true;
+
+    // 有新节点加入后按选定的顺序重新编号
+    if (m_nodeOrder != NodeOrdering::None && m_orderedNodeCount != m_nodesCount)
+        applyNodeOrder();
+}
+
+void Dijkstra::buildCsr()
+{
+    m_csr.clear();
+    m_csr.offsets.resize(m_nodesCount + 2);
+
+    int arcCount = 0;
+    for (int i = 1; i <= m_nodesCount; i++)
+        arcCount += m_nodes[i].edges.size();
+    m_csr.targets.reserve(arcCount);
+    m_csr.weights.reserve(arcCount);
+
+    // QMap 按键升序遍历，CSR 中每个节点的边也按目标索引有序
+    m_csr.offsets[0] = 0;
+    for (int i = 1; i <= m_nodesCount; i++)
+    {
+        m_csr.offsets[i] = m_csr.targets.size();
+        for (auto it = m_nodes[i].edges.begin(); it != m_nodes[i].edges.end(); ++it)
+        {
+            m_csr.targets.append(it.key());
+            m_csr.weights.append(it.value());
+        }
+    }
+    m_csr.offsets[m_nodesCount + 1] = m_csr.targets.size();
+
+    // 载入结束：ID 连续时把映射改为直接数组
+    m_idToIndex.compact();
+
+    if (!m_csr.weights.isEmpty())
+    {
+        auto range = std::minmax_element(m_csr.weights.constBegin(), m_csr.weights.constEnd());
+        m_csr.minWeight = *range.first;
+        m_csr.maxWeight = *range.second;
+    }
+}
+
+void Dijkstra::setNodeOrder(NodeOrdering::Method method)
+{
+    m_nodeOrder = method;
+    m_orderedNodeCount = -1;
+    if (m_frozen && method != NodeOrdering::None)
+        applyNodeOrder();
+}
+
+void Dijkstra::setNodeCoordinates(const QMap<long, QPointF> &coordinates)
+{
+    m_coordinates = coordinates;
+    if (m_frozen && m_nodeOrder == NodeOrdering::Hilbert)
+        applyNodeOrder();
+}
+
+void Dijkstra::applyNodeOrder()
+{
+    QHash<int, QPointF> coordinates;
+    if (m_nodeOrder == NodeOrdering::Hilbert)
+    {
+        for (auto it = m_coordinates.constBegin(); it != m_coordinates.constEnd(); ++it)
+        {
+            int index = m_idToIndex.value(it.key());
+            if (index != 0)
+                coordinates.insert(index, it.value());
+        }
+    }
+
+    QVector<int> order = NodeOrdering::compute(m_nodeOrder, m_csr, coordinates);
+    m_orderedNodeCount = m_nodesCount;
+    for (int k = 0; k < order.size(); k++)
+    {
+        if (order[k] != k + 1)
+        {
+            permuteNodes(order);
+            return;
+        }
+    }
+}
+
+void Dijkstra::permuteNodes(const QVector<int> &order)
+{
+    QVector<int> newIndex(m_nodesCount + 1, 0);
+    for (int k = 0; k < order.size(); k++)
+        newIndex[order[k]] = k + 1;
+
+    QVector<NodeInfo> nodes(m_nodesCount + 1);
+    m_idToIndex.clear();
+    for (int k = 1; k <= m_nodesCount; k++)
+    {
+        const NodeInfo &old = m_nodes[order[k - 1]];
+        NodeInfo &node = nodes[k];
+        node.id = old.id;
+        node.label = old.label;
+        for (auto it = old.edges.constBegin(); it != old.edges.constEnd(); ++it)
+            node.edges.insert(newIndex[it.key()], it.value());
+        m_idToIndex.insert(node.id, k);
+    }
+    m_nodes.swap(nodes);
+
+    // 按索引保存的搜索状态、缓存和索引结构全部失效
+    m_indexStart = 0;
+    m_searchFinished = false;
+    m_work.clear();
+    m_treeCache.clear();
+    m_graphVersion++;
+    m_alt.clear();
+    m_ch.clear();
+    m_cch.clear();
+    m_cchCustomized = false;
+    m_hub.clear();
+    m_arcFlags.clear();
+    m_delta.clear();
+    m_allPairs.close();
+    m_floyd.clear();
+    m_dense.clear();
+
+    buildCsr();
+}
+
+bool Dijkstra::buildLandmarks(int landmarkCount, AltIndex::Selection selection)
+{
+    if (m_nodesCount == 0)
+    {
+        m_errorDescription = "没有节点数据";
+        return false;
+    }
+
+    if (!m_frozen)
+        freeze();
+
+    m_altLandmarkCount = landmarkCount;
+    m_altSelection = selection;
+    if (!m_alt.build(m_csr, landmarkCount, selection))
+    {
+        m_errorDescription = "地标预处理失败";
+        return false;
+    }
+    return true;
+}
+
+bool Dijkstra::buildContractionHierarchy()
+{
+    if (m_nodesCount == 0)
+    {
+        m_errorDescription = "没有节点数据";
+        return false;
+    }
+
+    if (!m_frozen)
+        freeze();
+
+    if (!m_ch.build(m_csr))
+    {
+        m_errorDescription = "收缩层次预处理失败";
+        return false;
+    }
+    return true;
+}
+
+bool Dijkstra::buildCustomizableCH()
+{
+    if (m_nodesCount == 0)
+    {
+        m_errorDescription = "没有节点数据";
+        return false;
+    }
+
+    if (!m_frozen)
+        freeze();
+
+    m_cchCustomized = m_cch.build(m_csr);
+    if (!m_cchCustomized)
+    {
+        m_errorDescription = "可定制收缩层次预处理失败";
+        return false;
+    }
+    return true;
+}
+
+bool Dijkstra::customizeCH()
+{
+    if (m_cch.isEmpty())
+        return buildCustomizableCH();
+
+    if (!m_frozen)
+        freeze();
+
+    // 拓扑已变化时无法定制，退回完整预处理
+    m_cchCustomized = m_cch.customize(m_csr);
+    if (!m_cchCustomized)
+        return buildCustomizableCH();
+    return true;
+}
+
+bool Dijkstra::buildHubLabels(int threadCount)
+{
+    if (m_nodesCount == 0)
+    {
+        m_errorDescription = "没有节点数据";
+        return false;
+    }
+
+    if (!m_frozen)
+        freeze();
+
+    if (!m_hub.build(m_csr, threadCount))
+    {
+        m_errorDescription = "中心点标签预处理失败";
+        return false;
+    }
+    return true;
+}
+
+bool Dijkstra::saveHubLabels(const QString &fileName) const
+{
+    if (m_hub.isEmpty() || !m_frozen)
+        return false;
+    return m_hub.save(fileName, m_csr);
+}
+
+bool Dijkstra::loadHubLabels(const QString &fileName)
+{
+    if (m_nodesCount == 0)
+    {
+        m_errorDescription = "没有节点数据";
+        return false;
+    }
+
+    if (!m_frozen)
+        freeze();
+
+    if (!m_hub.load(fileName, m_csr))
+    {
+        m_errorDescription = QString("标签文件无效或与当前图不一致: %1").arg(fileName);
+        return false;
+    }
+    return true;
+}
+
+bool Dijkstra::buildArcFlags(int regionCount)
+{
+    if (m_nodesCount == 0)
+    {
+        m_errorDescription = "没有节点数据";
+        return false;
+    }
+
+    if (!m_frozen)
+        freeze();
+
+    m_arcFlagRegions = regionCount;
+    if (!m_arcFlags.build(m_csr, regionCount))
+    {
+        m_errorDescription = "弧标志预处理失败";
+        return false;
+    }
+    return true;
+}
+
+void Dijkstra::copySettings(const Dijkstra &other)
+{
+    m_earlyTermination = other.m_earlyTermination;
+    m_incrementalRepair = other.m_incrementalRepair;
+    m_queueType = other.m_queueType;
+    m_denseThreshold = other.m_denseThreshold;
+    m_altLandmarkCount = other.m_altLandmarkCount;
+    m_altSelection = other.m_altSelection;
+    m_arcFlagRegions = other.m_arcFlagRegions;
+    m_deltaThreads = other.m_deltaThreads;
+    m_matrixMethod = other.m_matrixMethod;
+    m_queryEngine = other.m_queryEngine;
+    setFloydWarshallLimit(other.m_floydLimit);
+    m_treeCache.setBudget(other.m_treeCache.budget());
+    m_indexStart = 0;
+    // 只记下重排方式，在下一次冻结时生效，不重排已载入的图
+    if (m_nodeOrder != other.m_nodeOrder)
+    {
+        m_nodeOrder = other.m_nodeOrder;
+        m_orderedNodeCount = -1;
+    }
+}
+
+void Dijkstra::copyGraph(const Dijkstra &other)
+{
+    clear();
+    copySettings(other);
+    m_nodes = other.m_nodes;
+    m_idToIndex = other.m_idToIndex;
+    m_nodesCount = other.m_nodesCount;
+    m_coordinates = other.m_coordinates;
+    m_csr = other.m_csr;
+    m_frozen = other.m_frozen;
+    m_orderedNodeCount = other.m_orderedNodeCount;
+    m_alt = other.m_alt;
+    m_ch = other.m_ch;
+    m_cch = other.m_cch;
+    m_cchCustomized = other.m_cchCustomized;
+    m_hub = other.m_hub;
+    m_hubLabelFile = other.m_hubLabelFile;
+    m_arcFlags = other.m_arcFlags;
+    m_floyd = other.m_floyd;
+    // 矩阵文件只读映射，副本重新映射同一文件
+    if (other.m_allPairs.isLoaded())
+        m_allPairs.load(other.m_allPairs.fileName(), m_csr);
+}
+
+void Dijkstra::prepareQueries()
+{
+    if (m_nodesCount == 0)
+        return;
+
+    if (!m_frozen)
+        freeze();
+    if (m_floydLimit > 0 && m_nodesCount <= m_floydLimit && m_floyd.isEmpty())
+        buildFloydWarshall();
+}
+
+void Dijkstra::setQueryEngine(QueryEngine engine)
+{
+    m_queryEngine = engine;
+}
+
+void Dijkstra::setIncrementalRepair(bool enabled)
+{
+    m_incrementalRepair = enabled;
+}
+
+void Dijkstra::setEarlyTermination(bool enabled)
+{
+    m_earlyTermination = enabled;
+}
+
+void Dijkstra::setDenseThreshold(double minDensity)
+{
+    if (m_denseThreshold != minDensity)
+    {
+        m_denseThreshold = minDensity;
+        m_indexStart = 0; // 自动选择的队列可能改变
+    }
+}
+
+void Dijkstra::setQueueType(QueueType type)
+{
+    if (m_queueType != type)
+    {
+        m_queueType = type;
+        m_indexStart = 0; // 切换队列后重新计算
+    }
+}
+
+Dijkstra::QueueType Dijkstra::effectiveQueueType() const
+{
+    bool nonNegative = m_csr.minWeight >= 0;
+    if (m_queueType == QueueAuto)
+    {
+        if (!nonNegative)
+            return QueueDaryHeap;
+        if (m_csr.uniformWeight() > 0)
+            return QueueBfs;
+        if (m_denseThreshold > 0 && DenseDijkstra::suitable(m_csr, m_denseThreshold))
+            return QueueDenseMatrix;
+        return m_csr.maxWeight <= DIAL_MAX_WEIGHT ? QueueDialBuckets : QueueRadixHeap;
+    }
+    // 单调整数队列不支持负边权
+    if (!nonNegative && (m_queueType == QueueDialBuckets || m_queueType == QueueRadixHeap))
+        return QueueDaryHeap;
+    // 节点过多或距离超出 32 位时无法展开矩阵
+    if (m_queueType == QueueDenseMatrix && !DenseDijkstra::suitable(m_csr, 0.0))
+        return QueueDaryHeap;
+    if (m_queueType == QueueBfs && m_csr.uniformWeight() == 0)
+        return QueueDaryHeap;
+    return m_queueType;
+}
+
+int Dijkstra::nodeCount() const
+{
+    return m_nodesCount;
+}
+
+int Dijkstra::nodeIndex(long idNode) const
+{
+    return m_idToIndex.value(idNode);
 }
 
 long Dijkstra::nodeID(int idxNode) const
@@ -408,9 +1877,9 @@ long Dijkstra::nodeID(int idxNode) const
 QMap<long, long> Dijkstra::getNodeNeighbors(long idNode) const
 {
     QMap<long, long> neighbors;
-    if (m_idToIndex.contains(idNode))
+    int index = m_idToIndex.value(idNode);
+    if (index != 0)
     {
-        int index = m_idToIndex[idNode];
         for (auto it = m_nodes[index].edges.begin(); it != m_nodes[index].edges.end(); ++it)
         {
             long neighborID = m_nodes[it.key()].id;
@@ -459,6 +1928,7 @@ Dijkstra::GraphStats Dijkstra::getGraphStats() const
     stats.edgeCount /= 2; // 无向图，每条边计算了两次
     stats.totalDistance /= 2;
     stats.avgDegree = m_nodesCount > 0 ? (double)totalDegree / m_nodesCount : 0.0;
+    stats.density = m_nodesCount > 1 ? (double)stats.edgeCount / (m_nodesCount * (m_nodesCount - 1.0) / 2.0) : 0.0;
 
     return stats;
 }
@@ -468,6 +1938,23 @@ void Dijkstra::clear()
     m_nodes.clear();
     m_nodes.append(NodeInfo());
     m_idToIndex.clear();
+    m_csr.clear();
+    m_frozen = false;
+    m_alt.clear();
+    m_ch.clear();
+    m_cch.clear();
+    m_hub.clear();
+    m_arcFlags.clear();
+    m_hubLabelFile.clear();
+    m_delta.clear();
+    m_allPairs.close();
+    m_floyd.clear();
+    m_dense.clear();
+    m_work.clear();
+    m_treeCache.clear();
+    m_graphVersion++;
+    m_coordinates.clear();
+    m_orderedNodeCount = 0;
     m_nodesCount = 0;
     m_indexStart = 0;
     m_errorDescription.clear();
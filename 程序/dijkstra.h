@@ -6,16 +6,61 @@
 #include <QMap>
 #include <QList>
 #include <functional>
+#include "dijkstra_heap.h"
+#include "dijkstra_csr.h"
+#include "dijkstra_alt.h"
+#include "dijkstra_ch.h"
+#include "dijkstra_cch.h"
+#include "dijkstra_hub.h"
+#include "dijkstra_arcflags.h"
+#include "dijkstra_delta.h"
+#include "dijkstra_matrix.h"
+#include "dijkstra_apsp.h"
+#include "dijkstra_floyd.h"
+#include "dijkstra_dense.h"
+#include "dijkstra_treecache.h"
+#include "dijkstra_workspace.h"
+#include "dijkstra_basic.h"
+#include "dijkstra_idmap.h"
+#include "dijkstra_order.h"
 #include <limits>
 
 // 回调函数类型：用于算法执行动画
 // 参数：当前访问的节点索引，当前距离，是否完成
 typedef std::function<void(int, long, bool)> AnimationCallback;
 
+// 把 BasicDijkstra 的搜索过程转给动画回调
+struct AnimationObserver
+{
+    explicit AnimationObserver(const AnimationCallback &callback) : callback(&callback) {}
+    void settled(int node, long distance) { (*callback)(node, distance, false); }
+    void improved(int node, long distance) { (*callback)(node, distance, false); }
+
+    const AnimationCallback *callback;
+};
+
+// 按确定顺序记录节点，只读查询据此把搜索结果写入最短路径树缓存
+struct SettledRecorder
+{
+    explicit SettledRecorder(QVector<int> *nodes) : nodes(nodes) {}
+    void settled(int node, long) { nodes->append(node); }
+    void improved(int, long) {}
+
+    QVector<int> *nodes;
+};
+
 // Dijkstra算法类
 class Dijkstra
 {
 public:
+    // 单源搜索使用的 BasicDijkstra 组合：getDistance 记录全部等长前驱（有动画回调时带观察者），
+    // query 只记录回溯前驱（启用树缓存时另记确定顺序），queryDistance 只算距离
+    typedef BasicDijkstra<long, int, true, true> TreeSearch;
+    typedef BasicDijkstra<long, int, true, true, AnimationObserver> AnimatedTreeSearch;
+    typedef BasicDijkstra<long, int, true, false> PathSearch;
+    typedef BasicDijkstra<long, int, true, false, SettledRecorder> RecordedPathSearch;
+    typedef BasicDijkstra<long, int, false, false> DistanceSearch;
+
     Dijkstra();
     ~Dijkstra();
 
@@ -25,6 +70,9 @@ public:
     // 手动添加节点和距离关系
     bool addNodesDist(long idNode1, long idNode2, long distance);
 
+    // 修改已有边的距离（双向）；图的拓扑不变，CCH 只需重新定制
+    bool setEdgeDistance(long idNode1, long idNode2, long distance);
+
     // 设置节点标签/名称
     void setNodeLabel(long idNode, const QString &label);
     QString getNodeLabel(long idNode) const;
@@ -33,6 +81,43 @@ public:
     int getDistance(long idNodeStart, long idNodeEnd, long &distance, QVector<long> &path, 
                     AnimationCallback animCallback = nullptr);
 
+    // 只读查询：与 getDistance 结果相同（等长路径可能不同），只读取冻结的 CSR 图，搜索状态写入 workspace，
+    // 不使用也不改变 getDistance 当前起点的搜索状态，因此多个线程可以同时查询同一张图
+    // 总是用单向 Dijkstra（与 getDistance 选用相同的队列），不使用 setQueryEngine 选定的查询引擎；
+    // 已算好的小图距离表（见 prepareQueries）或已载入的全源距离矩阵直接查表。需要按查询引擎查询或动画时用 getDistance
+    // 与 getDistance 共用最短路径树缓存（内部加锁）：先查缓存，未命中时搜索并把确定的节点写入缓存
+    // workspace 为空时使用线程局部的工作区；图须已冻结（loadFileData 后即冻结，修改图后需先调用 freeze()），
+    // 查询期间不能修改图。返回值与 getDistance 相同：成功为路径节点数，不可达为 -1，节点不存在或图未冻结为 0
+    int query(long idNodeStart, long idNodeEnd, long &distance, QVector<long> &path,
+              QueryWorkspace *workspace = nullptr) const;
+
+    // 只求距离的只读查询：不记录前驱，其余与 query 相同。返回 1 表示可达，-1 不可达，0 节点不存在或图未冻结
+    int queryDistance(long idNodeStart, long idNodeEnd, long &distance, QueryWorkspace *workspace = nullptr) const;
+
+    // 多对多距离矩阵：distances 按行优先写入 sources.size() × targets.size() 个距离，不可达为 CsrGraph::UNREACHABLE
+    // pathPairs 中的（行, 列）额外输出路径（节点ID）到 paths 的对应位置，不可达时为空
+    // 每个起点独立搜索并按线程分配，不影响 getDistance 缓存的搜索结果；threadCount <= 0 时使用全部核心
+    bool distanceMatrix(const QVector<long> &sources, const QVector<long> &targets, QVector<long> &distances,
+                        const QVector<QPair<int, int>> &pathPairs = QVector<QPair<int, int>>(),
+                        QVector<QVector<long>> *paths = nullptr, int threadCount = 0);
+    // distanceMatrix 每行的计算方式（默认按图和终点数自动选择）
+    void setDistanceMatrixMethod(DistanceMatrix::Method method) { m_matrixMethod = method; }
+    DistanceMatrix::Method distanceMatrixMethod() const { return m_matrixMethod; }
+
+    // 全源距离矩阵：每个起点一次单源搜索，并行写入内存映射文件，中断后再次调用从断点继续
+    // 载入完整且与当前图一致的矩阵后，getDistance 直接查表；图被修改后自动关闭
+    bool buildAllPairs(const QString &fileName, int threadCount = 0, int rowLimit = 0);
+    bool loadAllPairs(const QString &fileName);
+    void closeAllPairs() { m_allPairs.close(); }
+    const AllPairsMatrix &allPairs() const { return m_allPairs; }
+
+    // 小图距离表：节点数不超过 maxNodes 时，getDistance（无动画回调）首次查询用分块 Floyd–Warshall
+    // 算出全部距离和下一跳，之后直接查表；图被修改后下次查询时重算。0 表示不使用（默认）
+    void setFloydWarshallLimit(int maxNodes);
+    int floydWarshallLimit() const { return m_floydLimit; }
+    bool buildFloydWarshall(FloydWarshall::Kernel kernel = FloydWarshall::KernelAuto);
+    const FloydWarshall &floydWarshall() const { return m_floyd; }
+
     // 获取当前已加载的节点数量
     int nodeCount() const;
 
@@ -56,12 +141,144 @@ public:
         int maxDegree;
         int minDegree;
         long totalDistance;
+        double density;         // 边数 / 完全图边数
     };
     GraphStats getGraphStats() const;
 
     // 清空所有数据
     void clear();
 
+    // 写时复制：复制 other 的图数据（节点、边、标签、坐标、CSR）和查询设置，在副本上修改后再发布
+    // 已建好的索引（ALT、CH、CCH、中心点标签、弧标志、距离表、全源距离矩阵）随副本保留，修改图时照常失效或重新定制；
+    // 搜索状态和树缓存不复制
+    void copyGraph(const Dijkstra &other);
+
+    // 发布前的准备：冻结图，节点数不超过距离表上限时算好距离表；之后只读查询不再改动图
+    void prepareQueries();
+
+    // 沿用 other 的查询设置（队列类型、查询引擎、提前终止、增量修复、预处理参数、缓存预算等），不复制图数据和索引
+    // 重新载入时在新建的空图上调用，节点重排方式在载入结束的冻结时生效，之后再加载 .hub/.apsp 等索引文件
+    void copySettings(const Dijkstra &other);
+
+    // 优先队列类型（每个实例可单独选择）
+    enum QueueType {
+        QueueLinearScan,        // 线性扫描（原始实现，O(V²)）
+        QueueDaryHeap,          // 带索引的4叉堆，支持降键
+        QueueLazyBinaryHeap,    // 惰性删除二叉堆
+        QueueDialBuckets,       // Dial 桶队列（非负整数边权，最大边权较小）
+        QueueRadixHeap,         // 基数堆（非负整数边权）
+        QueueAuto,              // 按加载时统计的边权范围和图密度自动选择（默认）
+        QueueDenseMatrix,       // 稠密图：V×V 边权矩阵 + SIMD 选最小（非负边权，最多 DenseDijkstra::MAX_NODES 个节点）
+        QueueBfs                // 先进先出队列，即广度优先搜索（全部边权相同）
+    };
+    void setQueueType(QueueType type);
+    QueueType queueType() const { return m_queueType; }
+
+    // 实际使用的队列类型：QueueAuto 时全部边权相同（载入时判定）选广度优先搜索，图密度不低于稠密阈值选矩阵搜索，
+    // 否则最大边权不超过 DIAL_MAX_WEIGHT 选 Dial 桶队列，再否则选基数堆；存在负边权时退回4叉堆
+    QueueType effectiveQueueType() const;
+    static const long DIAL_MAX_WEIGHT;
+
+    // QueueAuto 改用矩阵搜索的最低图密度（边数 / 完全图边数），不大于 0 或大于 1 时不自动选择
+    void setDenseThreshold(double minDensity);
+    double denseThreshold() const { return m_denseThreshold; }
+    static const double DEFAULT_DENSE_THRESHOLD;
+
+    // 查询引擎（getDistance 使用，便于 A/B 对比）
+    // 预处理类引擎和 delta-stepping 要求非负边权，存在负边权时索引构建失败，getDistance 退回单向 Dijkstra
+    enum QueryEngine {
+        EngineDijkstra,         // 单向 Dijkstra（calculate）
+        EngineBidirectional,    // 双向 Dijkstra
+        EngineALT,              // 地标下界引导的 A*（需 ALT 预处理）
+        EngineCH,               // 收缩层次（需 CH 预处理）
+        EngineCCH,              // 可定制收缩层次（需 CCH 预处理）
+        EngineHubLabels,        // 中心点标签距离预言机（需标签预处理）
+        EngineArcFlags,         // 弧标志剪枝的 Dijkstra（需弧标志预处理）
+        EngineDeltaStepping     // 并行 delta-stepping（一次算出起点到全部节点，同一起点的后续查询直接复用）
+    };
+    void setQueryEngine(QueryEngine engine);
+    QueryEngine queryEngine() const { return m_queryEngine; }
+
+    // ALT 预处理：选择 landmarkCount 个地标并按地标并行计算距离数组
+    // 图被修改后索引失效，ALT 引擎下次查询时按相同参数自动重建
+    bool buildLandmarks(int landmarkCount = 16, AltIndex::Selection selection = AltIndex::SelectFarthest);
+    const AltIndex &landmarkIndex() const { return m_alt; }
+    qint64 landmarkMemoryUsage() const { return m_alt.memoryUsage(); }
+
+    // 收缩层次预处理：按边差排序收缩全部节点并生成捷径
+    // 图被修改后失效，CH 引擎下次查询时自动重建
+    bool buildContractionHierarchy();
+    const ContractionHierarchy &contractionHierarchy() const { return m_ch; }
+
+    // 可定制收缩层次：嵌套剖分排序并建立向上图拓扑，然后按当前边权定制
+    // 只修改边权（setEdgeDistance）时拓扑保留，CCH 引擎下次查询前自动重新定制；
+    // 增加节点或边后拓扑失效，下次查询时重建
+    bool buildCustomizableCH();
+    bool customizeCH();
+    const CustomizableCH &customizableCH() const { return m_cch; }
+
+    // 中心点标签：剪枝地标标签并行构建，查询只需归并两个有序数组
+    // 设置了标签文件时，标签引擎首次查询先尝试从文件载入（图指纹一致才使用），
+    // 否则构建后写入该文件；图被修改后标签失效，下次查询时重建
+    bool buildHubLabels(int threadCount = 0);
+    bool saveHubLabels(const QString &fileName) const;
+    bool loadHubLabels(const QString &fileName);
+    void setHubLabelFile(const QString &fileName) { m_hubLabelFile = fileName; }
+    QString hubLabelFile() const { return m_hubLabelFile; }
+    const HubLabels &hubLabels() const { return m_hub; }
+
+    // 弧标志预处理：划分 regionCount 个区域，按区域并行计算每条边的区域位集
+    // 图被修改后失效，弧标志引擎下次查询时按相同区域数自动重建
+    bool buildArcFlags(int regionCount = 32);
+    const ArcFlags &arcFlags() const { return m_arcFlags; }
+
+    // 并行 delta-stepping：计算起点到全部节点的距离和父节点列表，结果与单线程搜索一致，
+    // 之后同一起点的 getDistance 直接回溯路径；threadCount <= 0 时使用全部核心，delta <= 0 时按边权分布自动选择
+    bool calculateDeltaStepping(long idNodeStart, int threadCount = 0, long delta = 0);
+    void setDeltaSteppingThreads(int threadCount) { m_deltaThreads = threadCount; }
+    int deltaSteppingThreads() const { return m_deltaThreads; }
+    const DeltaStepping &deltaStepping() const { return m_delta; }
+
+    // 最短路径树缓存：单向 Dijkstra 换用新起点前，把上一个起点已确定的距离和前驱存入按起点的 LRU 缓存，
+    // 之后回到该起点（无动画回调）且终点已确定时直接回溯，不再搜索；预算不大于 0 时不缓存
+    // 提前终止的搜索只存已确定的节点，换起点的代价与搜索范围成正比
+    // 缓存条目带图版本，addNodesDist、setEdgeDistance 和 clear 递增版本使其失效
+    // 并发的 query() 同样查找和写入缓存，各线程的查询结果互相复用
+    void setTreeCacheBudget(qint64 bytes) { m_treeCache.setBudget(bytes); }
+    qint64 treeCacheBudget() const { return m_treeCache.budget(); }
+    ShortestPathTreeCache &treeCache() { return m_treeCache; }
+    const ShortestPathTreeCache &treeCache() const { return m_treeCache; }
+    quint64 graphVersion() const { return m_graphVersion; }
+
+    // 最近一次 getDistance 确定（出队）的节点数，用于比较各引擎的搜索范围
+    int settledNodeCount() const { return m_settledCount; }
+
+    // 增量修复模式：当前起点已有完整的最短路径树时（关闭提前终止，或搜索已遍历整个连通分量），
+    // addNodesDist 加边或 setEdgeDistance 改边权后就地修复这棵树而不是丢弃：加边和边权变小时从边的端点重新松弛距离变小的节点；
+    // 边权变大时按 Ramalingam–Reps 先找出失去全部最短路径前驱的节点，再只在这些节点上重新计算
+    // 修复的代价与距离改变的节点数成正比；不会为了修复而强制完整搜索，存在负边权或只有部分的树时仍重新计算（默认关闭，界面不开启，由调用方按需启用）
+    void setIncrementalRepair(bool enabled);
+    bool incrementalRepair() const { return m_incrementalRepair; }
+
+    // 点对点模式：getDistance 在终点确定后即停止搜索（默认开启）
+    // 未完成的搜索保留在内存中，同一起点的后续查询会继续使用
+    void setEarlyTermination(bool enabled);
+    bool earlyTermination() const { return m_earlyTermination; }
+
+    // 冻结图结构：由邻接表构建CSR数组供搜索使用
+    // 图被修改后自动解冻，下次计算时重新构建
+    void freeze();
+    bool isFrozen() const { return m_frozen; }
+    const CsrGraph &csrGraph() const { return m_csr; }
+
+    // 节点重排（默认不重排）：有新节点加入后的下一次冻结按选定的顺序重新编号节点，已冻结的图设置后立即重排
+    // 节点 ID 和图不变，邻接表、ID 映射随之重建，索引结构和当前的搜索状态（包括增量修复中的树）需重新计算；
+    // getAllNodeIDs 等按索引列出的顺序会改变
+    void setNodeOrder(NodeOrdering::Method method);
+    NodeOrdering::Method nodeOrder() const { return m_nodeOrder; }
+    // Hilbert 重排使用的节点坐标（按节点 ID，如可视化布局的位置）
+    void setNodeCoordinates(const QMap<long, QPointF> &coordinates);
+
     // 错误信息
     QString errorDescription() const { return m_errorDescription; }
 
@@ -72,23 +289,133 @@ private:
         long id;                    // 节点ID
         QString label;              // 节点标签/名称
         QMap<int, long> edges;      // 邻接边：key=邻接节点索引，value=距离
-        bool visited;               // 是否已访问
-        long distance;              // 当前最短距离
-        QList<int> parents;         // 父节点列表（支持多条最短路径）
 
-        NodeInfo() : id(0), visited(false), distance(std::numeric_limits<long>::max()) {}
+        NodeInfo() : id(0) {}
     };
 
     // 计算从起始节点开始的最短路径（支持动画回调）
-    bool calculate(long idNodeStart, AnimationCallback animCallback = nullptr);
+    // iTarget > 0 时在该节点确定后暂停，同一起点的后续调用从暂停处继续
+    bool calculate(long idNodeStart, AnimationCallback animCallback = nullptr, int iTarget = 0);
+
+    // 各查询引擎：成功返回 1 并填写起点到终点的节点索引，不可达返回 -1，出错返回 0
+    int queryDijkstra(int iStart, int iEnd, long &distance, QVector<int> &pathIndices,
+                      const AnimationCallback &animCallback);
+    int queryBidirectional(int iStart, int iEnd, long &distance, QVector<int> &pathIndices,
+                           const AnimationCallback &animCallback);
+    int queryAlt(int iStart, int iEnd, long &distance, QVector<int> &pathIndices,
+                 const AnimationCallback &animCallback);
+    int queryCH(int iStart, int iEnd, long &distance, QVector<int> &pathIndices,
+                const AnimationCallback &animCallback);
+    int queryCCH(int iStart, int iEnd, long &distance, QVector<int> &pathIndices,
+                 const AnimationCallback &animCallback);
+    int queryHubLabels(int iStart, int iEnd, long &distance, QVector<int> &pathIndices,
+                       const AnimationCallback &animCallback);
+    int queryArcFlags(int iStart, int iEnd, long &distance, QVector<int> &pathIndices,
+                      const AnimationCallback &animCallback);
+    int queryDeltaStepping(int iStart, int iEnd, long &distance, QVector<int> &pathIndices,
+                           const AnimationCallback &animCallback);
+    int queryAllPairs(int iStart, int iEnd, long &distance, QVector<int> &pathIndices,
+                      const AnimationCallback &animCallback) const;
+    int queryFloydWarshall(int iStart, int iEnd, long &distance, QVector<int> &pathIndices);
+    // 查已算好的距离表（不构建）
+    int lookupFloydWarshall(int iStart, int iEnd, long &distance, QVector<int> &pathIndices) const;
+    int queryTree(const ShortestPathTree &tree, int iEnd, long &distance, QVector<int> &pathIndices);
+
+    // 把搜索状态中当前起点的结果存入最短路径树缓存（重新开始搜索前调用）
+    void cacheSearchTree();
+
+    // 边 index1-index2 的边权由 oldWeight（新加的边为 MAX_DISTANCE）变为 newWeight 后修复当前起点的最短路径树，
+    // 不能修复时返回 false，由调用方放弃当前搜索
+    bool repairSearchTree(int index1, int index2, long oldWeight, long newWeight);
+    void repairDecrease(int index1, int index2, long weight);
+    void repairIncrease(int index1, int index2);
+    // 修复时经边 u-v（边权 weight）松弛 v，距离变小时放入 m_lazyHeap
+    void relaxRepair(int u, int v, long weight);
+
+    // 使用指定优先队列执行搜索主循环，返回队列是否已耗尽（搜索完成）
+    template <typename Queue>
+    bool runSearch(Queue &queue, bool restart, int iStart, int iTarget,
+                   const AnimationCallback &animCallback);
+    // 稠密图矩阵搜索的主循环，确定的节点逐个写回搜索状态（每个节点只记录一个前驱），其余语义与 runSearch 相同
+    bool runDenseSearch(bool restart, int iStart, int iTarget, const AnimationCallback &animCallback);
+
+    // 由邻接表构建 CSR 数组
+    void buildCsr();
+    // 按 m_nodeOrder 计算新顺序并重新编号节点（CSR 须与邻接表一致）
+    void applyNodeOrder();
+    // 新索引 k + 1 的节点为原索引 order[k]：重排邻接表和 ID 映射，丢弃按索引保存的数据，重建 CSR
+    void permuteNodes(const QVector<int> &order);
 
     static const long MAX_DISTANCE;  // 最大距离值
 
     QVector<NodeInfo> m_nodes;      // 节点数组（索引从1开始，0不使用）
-    QMap<long, int> m_idToIndex;    // 节点ID到索引的映射
+    SearchWorkspace m_work;          // 当前起点的搜索状态（距离、访问标记、父节点列表）
+    NodeIdMap m_idToIndex;          // 节点ID到索引的映射（ID 连续时为直接数组）
     int m_nodesCount;                // 节点数量
     int m_indexStart;                // 当前计算的起始节点索引
+    bool m_searchFinished;           // 当前起点的搜索是否已遍历完整个连通分量
+    bool m_earlyTermination;         // 是否启用点对点提前终止
+    bool m_incrementalRepair;        // 修改图时是否修复当前起点的最短路径树
     QString m_errorDescription;      // 错误描述
+
+    CsrGraph m_csr;                  // 冻结后的CSR邻接数组
+    bool m_frozen;                   // CSR是否与邻接表一致
+
+    QueueType m_queueType;           // 当前使用的优先队列类型
+    ScanQueue m_scanQueue;
+    DaryHeap<4> m_daryHeap;
+    LazyBinaryHeap m_lazyHeap;
+    DialQueue m_dialQueue;
+    RadixHeap m_radixHeap;
+    FifoQueue m_fifoQueue;
+    DenseDijkstra m_dense;           // 稠密图的边权矩阵（首次使用时展开）
+    double m_denseThreshold;         // QueueAuto 选择矩阵搜索的最低密度
+
+    // 双向搜索的单侧状态，只复位被访问过的节点
+    struct SearchSide
+    {
+        QVector<long> distance;
+        QVector<int> parent;
+        QVector<bool> settled;
+        QVector<int> touched;       // 本次搜索写过的节点
+        DaryHeap<4> heap;
+
+        void reset(int nodeCount);
+    };
+    SearchSide m_sides[2];           // 0：正向（起点出发），1：反向（终点出发）
+
+    AltIndex m_alt;                  // ALT 地标索引
+    int m_altLandmarkCount;          // 地标数量（自动重建时使用）
+    AltIndex::Selection m_altSelection;
+
+    ContractionHierarchy m_ch;       // 收缩层次
+    CustomizableCH m_cch;            // 可定制收缩层次
+    bool m_cchCustomized;            // CCH 边权是否与当前图一致
+
+    HubLabels m_hub;                 // 中心点标签
+    QString m_hubLabelFile;          // 标签缓存文件（与图数据放在一起）
+
+    ArcFlags m_arcFlags;             // 弧标志
+    int m_arcFlagRegions;            // 区域数量（自动重建时使用）
+
+    DeltaStepping m_delta;           // 最近一次并行搜索的结果
+    int m_deltaThreads;              // 并行搜索线程数（0 表示全部核心）
+
+    DistanceMatrix::Method m_matrixMethod;  // 多对多距离矩阵的计算方式
+    AllPairsMatrix m_allPairs;       // 已载入的全源距离矩阵
+
+    FloydWarshall m_floyd;           // 小图距离与下一跳表
+    int m_floydLimit;                // 使用距离表的最大节点数（0 表示不使用）
+
+    quint64 m_graphVersion;          // 图版本，每次修改图时递增
+    mutable ShortestPathTreeCache m_treeCache;  // 按起点缓存的最短路径树（内部加锁，只读查询也可写入）
+
+    QueryEngine m_queryEngine;       // 当前查询引擎
+    int m_settledCount;              // 最近一次查询确定的节点数
+
+    NodeOrdering::Method m_nodeOrder;       // 冻结时的节点重排方式
+    int m_orderedNodeCount;          // 上次重排时的节点数，节点数改变后重新重排
+    QMap<long, QPointF> m_coordinates;      // 节点坐标（Hilbert 重排使用）
 };
 
 #endif // DIJKSTRA_H
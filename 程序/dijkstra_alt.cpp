@@ -0,0 +1,248 @@
+#include "dijkstra_alt.h"
+#include "dijkstra_heap.h"
+#include <QtConcurrent>
+#include <QRandomGenerator>
+
+AltIndex::AltIndex()
+    : m_stride(0)
+    , m_selection(SelectFarthest)
+{
+}
+
+bool AltIndex::build(const CsrGraph &graph, int landmarkCount, Selection selection)
+{
+    clear();
+
+    // 三角不等式下界要求非负边权
+    int n = graph.nodeCount();
+    if (n == 0 || landmarkCount <= 0 || graph.minWeight < 0)
+        return false;
+
+    m_selection = selection;
+    m_stride = qMin(landmarkCount, n);
+    m_distances.fill(qint32(CsrGraph::UNREACHABLE), qint64(n + 1) * m_stride);
+
+    if (selection == SelectAvoid)
+    {
+        // avoid 依赖已选地标的下界，地标只能逐个确定
+        selectAvoid(graph, m_stride);
+    }
+    else
+    {
+        // 最远点选择只需剪枝搜索，选完后再并行计算全部距离数组
+        selectFarthest(graph, m_stride);
+        computeDistances(graph, 0);
+    }
+    return true;
+}
+
+void AltIndex::clear()
+{
+    m_landmarks.clear();
+    m_distances.clear();
+    m_distances.squeeze();
+    m_stride = 0;
+}
+
+qint64 AltIndex::memoryUsage() const
+{
+    return qint64(m_distances.capacity()) * sizeof(qint32)
+         + qint64(m_landmarks.capacity()) * sizeof(int);
+}
+
+void AltIndex::selectFarthest(const CsrGraph &graph, int landmarkCount)
+{
+    int n = graph.nodeCount();
+    const int *offsets = graph.offsets.constData();
+    const int *targets = graph.targets.constData();
+    const long *weights = graph.weights.constData();
+
+    // nearest[v]：v 到已选地标的最近距离
+    QVector<long> nearest(n + 1, CsrGraph::UNREACHABLE);
+    QVector<long> dist(n + 1, CsrGraph::UNREACHABLE);
+    QVector<int> touched;
+    DaryHeap<4> heap;
+
+    // 从 source 出发的剪枝搜索：只扩展距离比现有最近地标更近的节点，
+    // 即新地标的 Voronoi 区域，远小于一次完整搜索
+    auto grow = [&](int source) {
+        heap.reset(n);
+        dist[source] = 0;
+        touched.append(source);
+        heap.push(source, 0);
+        while (!heap.isEmpty())
+        {
+            long d;
+            int u = heap.pop(d);
+            if (d >= nearest[u])
+                continue;
+            nearest[u] = d;
+            for (int e = offsets[u]; e < offsets[u + 1]; e++)
+            {
+                int v = targets[e];
+                long nd = d + weights[e];
+                if (nd < dist[v] && nd < nearest[v])
+                {
+                    if (dist[v] == CsrGraph::UNREACHABLE)
+                        touched.append(v);
+                    dist[v] = nd;
+                    heap.push(v, nd);
+                }
+            }
+        }
+        for (int i = 0; i < touched.size(); i++)
+            dist[touched[i]] = CsrGraph::UNREACHABLE;
+        touched.clear();
+    };
+
+    // 距已选地标最远的节点；不可达节点优先，使每个连通分量都能分到地标
+    auto farthest = [&]() {
+        int best = 1;
+        for (int v = 2; v <= n; v++)
+        {
+            if (nearest[v] > nearest[best])
+                best = v;
+        }
+        return best;
+    };
+
+    // 第一个地标取距节点 1 最远的节点
+    grow(1);
+    int candidate = farthest();
+    nearest.fill(CsrGraph::UNREACHABLE);
+
+    while (m_landmarks.size() < landmarkCount)
+    {
+        m_landmarks.append(candidate);
+        grow(candidate);
+        candidate = farthest();
+        if (nearest[candidate] == 0)
+            break;  // 所有节点都已是地标
+    }
+}
+
+void AltIndex::selectAvoid(const CsrGraph &graph, int landmarkCount)
+{
+    int n = graph.nodeCount();
+    QRandomGenerator rng(20240601);
+
+    QVector<bool> isLandmark(n + 1, false);
+    QVector<long> dist;
+    QVector<int> parent, order;
+    QVector<qint64> size(n + 1);
+    QVector<bool> blocked(n + 1);
+    QVector<int> childOffsets(n + 2), children(n);
+
+    int attempts = 0;
+    while (m_landmarks.size() < landmarkCount && attempts < 4 * landmarkCount)
+    {
+        attempts++;
+
+        // 随机根节点的最短路径树
+        int root = 1 + rng.bounded(n);
+        graph.shortestPaths(root, dist, &parent, &order);
+
+        // size(v)：子树中 d(r, v) 与下界之差的总和；子树含地标时为 0
+        size.fill(0);
+        blocked.fill(false);
+        for (int i = order.size() - 1; i >= 0; i--)
+        {
+            int v = order[i];
+            int p = parent[v];
+            if (isLandmark[v])
+                blocked[v] = true;
+            if (blocked[v])
+            {
+                size[v] = 0;
+                if (p)
+                    blocked[p] = true;
+                continue;
+            }
+            size[v] += dist[v] - (m_landmarks.isEmpty() ? 0 : lowerBound(root, v));
+            if (p)
+                size[p] += size[v];
+        }
+
+        // 按父节点分组的子节点列表
+        childOffsets.fill(0);
+        for (int i = 0; i < order.size(); i++)
+            childOffsets[parent[order[i]] + 1]++;
+        for (int v = 1; v <= n + 1; v++)
+            childOffsets[v] += childOffsets[v - 1];
+        QVector<int> cursor = childOffsets;
+        for (int i = 0; i < order.size(); i++)
+        {
+            int v = order[i];
+            if (v != root)
+                children[cursor[parent[v]]++] = v;
+        }
+
+        // 从根出发沿 size 最大的子节点下行，直到叶子
+        int current = root;
+        while (true)
+        {
+            int best = 0;
+            for (int c = childOffsets[current]; c < childOffsets[current + 1]; c++)
+            {
+                int child = children[c];
+                if (size[child] > 0 && (best == 0 || size[child] > size[best]))
+                    best = child;
+            }
+            if (best == 0)
+                break;
+            current = best;
+        }
+
+        if (isLandmark[current] || (current == root && blocked[root]))
+            continue;
+
+        isLandmark[current] = true;
+        m_landmarks.append(current);
+        computeDistances(graph, m_landmarks.size() - 1);
+    }
+
+    // 随机根始终落在已覆盖区域时，用距已选地标最远的节点补足
+    while (m_landmarks.size() < landmarkCount)
+    {
+        int best = 0;
+        long bestDist = -1;
+        for (int v = 1; v <= n; v++)
+        {
+            if (isLandmark[v])
+                continue;
+            long nearest = CsrGraph::UNREACHABLE;
+            for (int i = 0; i < m_landmarks.size(); i++)
+                nearest = qMin(nearest, long(row(v)[i]));
+            if (nearest > bestDist)
+            {
+                best = v;
+                bestDist = nearest;
+            }
+        }
+        if (best == 0)
+            break;
+        isLandmark[best] = true;
+        m_landmarks.append(best);
+        computeDistances(graph, m_landmarks.size() - 1);
+    }
+}
+
+void AltIndex::computeDistances(const CsrGraph &graph, int first)
+{
+    QVector<int> columns;
+    for (int i = first; i < m_landmarks.size(); i++)
+        columns.append(i);
+
+    int n = graph.nodeCount();
+    int stride = m_stride;
+    qint32 *out = m_distances.data();
+    const QVector<int> &landmarks = m_landmarks;
+
+    // 每个地标一次完整搜索，写入各自的列
+    QtConcurrent::blockingMap(columns, [&graph, &landmarks, out, n, stride](int column) {
+        QVector<long> dist;
+        graph.shortestPaths(landmarks[column], dist);
+        for (int v = 0; v <= n; v++)
+            out[qint64(v) * stride + column] = qint32(dist[v]);
+    });
+}
@@ -0,0 +1,75 @@
+#ifndef DIJKSTRA_ALT_H
+#define DIJKSTRA_ALT_H
+
+#include "dijkstra_csr.h"
+#include <QVector>
+#include <QtGlobal>
+
+// ALT（A*、地标、三角不等式）预处理索引
+// 选出 K 个地标并保存每个地标到所有节点的最短距离，
+// 查询时由三角不等式得到任意两点距离的下界：
+//   d(v, t) >= max_L |d(L, t) - d(L, v)|
+// 距离按节点连续存放（第 v 行为 K 个地标到 v 的距离），查询时访存局部
+class AltIndex
+{
+public:
+    // 地标选择策略
+    enum Selection {
+        SelectFarthest,     // 最远点：每次选距现有地标最远的节点
+        SelectAvoid         // avoid 启发式：选下界最差的最短路径树子树的叶子
+    };
+
+    AltIndex();
+
+    // 在图上选择 landmarkCount 个地标并计算距离数组
+    // 距离数组按地标并行计算（QtConcurrent）；存在负边权时返回 false
+    bool build(const CsrGraph &graph, int landmarkCount, Selection selection = SelectFarthest);
+
+    void clear();
+    bool isEmpty() const { return m_landmarks.isEmpty(); }
+
+    int landmarkCount() const { return m_landmarks.size(); }
+    const QVector<int> &landmarks() const { return m_landmarks; }
+    Selection selection() const { return m_selection; }
+
+    // from 到 to 的距离下界；可确定二者不连通时返回 CsrGraph::UNREACHABLE
+    long lowerBound(int from, int to) const
+    {
+        const qint32 *a = row(from);
+        const qint32 *b = row(to);
+        long bound = 0;
+        for (int i = 0; i < m_landmarks.size(); i++)
+        {
+            bool reachA = a[i] < CsrGraph::UNREACHABLE;
+            bool reachB = b[i] < CsrGraph::UNREACHABLE;
+            if (reachA != reachB)
+                return CsrGraph::UNREACHABLE;
+            if (reachA)
+            {
+                long diff = long(a[i]) - long(b[i]);
+                if (diff < 0)
+                    diff = -diff;
+                if (diff > bound)
+                    bound = diff;
+            }
+        }
+        return bound;
+    }
+
+    // 占用内存（字节）
+    qint64 memoryUsage() const;
+
+private:
+    const qint32 *row(int node) const { return m_distances.constData() + qint64(node) * m_stride; }
+
+    void selectFarthest(const CsrGraph &graph, int landmarkCount);
+    void selectAvoid(const CsrGraph &graph, int landmarkCount);
+    void computeDistances(const CsrGraph &graph, int first);
+
+    QVector<int> m_landmarks;       // 地标节点索引
+    QVector<qint32> m_distances;    // (n + 1) × K，按节点存放
+    int m_stride;                   // 每行的地标数 K
+    Selection m_selection;
+};
+
+#endif // DIJKSTRA_ALT_H
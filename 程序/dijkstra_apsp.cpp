@@ -0,0 +1,284 @@
+#include "dijkstra_apsp.h"
+#include "dijkstra_bfs.h"
+#include "dijkstra_lanes.h"
+#include <QAtomicInteger>
+#include <QThread>
+#include <QtConcurrent>
+#include <algorithm>
+
+namespace {
+
+const quint32 APSP_FILE_MAGIC = 0x50535041;    // "APSP"
+const quint32 APSP_FILE_VERSION = 1;
+
+// 矩阵文件头，其后为 nodeCount 个行完成标志（补齐到 8 字节），再后为 nodeCount × nodeCount 的距离
+struct ApspFileHeader
+{
+    quint32 magic;
+    quint32 version;
+    quint64 fingerprint;
+    qint32 nodeCount;
+    qint32 elementSize;
+    qint64 reserved;
+};
+
+qint64 flagsOffset()
+{
+    return sizeof(ApspFileHeader);
+}
+
+qint64 matrixOffset(int nodeCount)
+{
+    return (flagsOffset() + nodeCount + 7) / 8 * 8;
+}
+
+qint64 fileSize(int nodeCount, int elementSize)
+{
+    return matrixOffset(nodeCount) + qint64(nodeCount) * nodeCount * elementSize;
+}
+
+bool readHeader(QFile &file, ApspFileHeader &header)
+{
+    return file.read(reinterpret_cast<char *>(&header), sizeof(header)) == qint64(sizeof(header))
+        && header.magic == APSP_FILE_MAGIC && header.version == APSP_FILE_VERSION;
+}
+
+} // namespace
+
+AllPairsMatrix::AllPairsMatrix()
+    : m_matrix(nullptr)
+    , m_nodeCount(0)
+    , m_elementSize(0)
+    , m_completedRows(0)
+{
+}
+
+AllPairsMatrix::~AllPairsMatrix()
+{
+    close();
+}
+
+int AllPairsMatrix::chooseElementSize(const CsrGraph &graph)
+{
+    // 任意最短路径至多 n - 1 条边
+    qint64 bound = qint64(qMax(graph.maxWeight, 0L)) * qMax(graph.nodeCount() - 1, 1);
+    return graph.minWeight >= 0 && bound < CsrGraph::UNREACHABLE ? 4 : 8;
+}
+
+qint64 AllPairsMatrix::matrixBytes(const CsrGraph &graph)
+{
+    return qint64(graph.nodeCount()) * graph.nodeCount() * chooseElementSize(graph);
+}
+
+bool AllPairsMatrix::build(const CsrGraph &graph, const QString &fileName, int threadCount, int rowLimit)
+{
+    close();
+
+    int n = graph.nodeCount();
+    if (n == 0)
+        return false;
+    if (threadCount <= 0)
+        threadCount = QThread::idealThreadCount();
+
+    ApspFileHeader expected = { APSP_FILE_MAGIC, APSP_FILE_VERSION, graph.fingerprint(),
+                                qint32(n), qint32(chooseElementSize(graph)), 0 };
+    qint64 size = fileSize(n, expected.elementSize);
+
+    // 同一张图的未完成文件从断点继续，否则重新创建（扩展出的部分读出为 0，即全部行未完成）
+    m_file.setFileName(fileName);
+    if (!m_file.open(QIODevice::ReadWrite))
+        return false;
+    ApspFileHeader header;
+    bool resume = m_file.size() == size && readHeader(m_file, header)
+               && header.fingerprint == expected.fingerprint && header.nodeCount == expected.nodeCount
+               && header.elementSize == expected.elementSize;
+    if (!resume)
+    {
+        bool ok = m_file.resize(0) && m_file.seek(0)
+               && m_file.write(reinterpret_cast<const char *>(&expected), sizeof(expected)) == qint64(sizeof(expected))
+               && m_file.flush() && m_file.resize(size);
+        if (!ok)
+        {
+            m_file.close();
+            return false;
+        }
+    }
+
+    uchar *data = m_file.map(0, size);
+    if (!data)
+    {
+        m_file.close();
+        return false;
+    }
+    uchar *flags = data + flagsOffset();
+    uchar *matrix = data + matrixOffset(n);
+    int elementSize = expected.elementSize;
+
+    QVector<int> pending;
+    for (int row = 1; row <= n; row++)
+    {
+        if (!flags[row - 1])
+            pending.append(row);
+    }
+    if (rowLimit > 0 && pending.size() > rowLimit)
+        pending.resize(rowLimit);
+
+    // 全部边权相同时每次领取 64 行做一次位并行 BFS（结果位置即节点索引 - 1），
+    // 否则距离在 32 位内时每次领取 8 行做一次 SIMD 批量搜索，再否则逐行 Dijkstra
+    bool uniform = graph.uniformWeight() > 0;
+    bool lanes = !uniform && LaneBatchSearch::suitable(graph);
+    int rowsPerTask = uniform ? MultiSourceBfs::BATCH : (lanes ? LaneBatchSearch::LANES : 1);
+    QVector<int> identity;
+    if (uniform)
+    {
+        for (int v = 0; v <= n; v++)
+            identity.append(v - 1);
+    }
+
+    // 各线程动态领取行，先写距离再置完成标志
+    QVector<int> workers;
+    int tasks = (pending.size() + rowsPerTask - 1) / rowsPerTask;
+    for (int w = 0; w < qMin(threadCount, tasks); w++)
+        workers.append(w);
+    QAtomicInt next(0);
+    QtConcurrent::blockingMap(workers, [&graph, &pending, &identity, &next, uniform, lanes, rowsPerTask, flags,
+                                        matrix, elementSize, n](int) {
+        QVector<long> distance(n + 1);
+        MultiSourceBfs bfs;
+        LaneBatchSearch batch;
+        if (lanes)
+            batch.init(graph);
+        for (int i = next.fetchAndAddRelaxed(rowsPerTask); i < pending.size();
+             i = next.fetchAndAddRelaxed(rowsPerTask))
+        {
+            int count = qMin(rowsPerTask, int(pending.size()) - i);
+            if (uniform)
+                bfs.run(graph, pending.constData() + i, count, identity, n);
+            else if (lanes)
+                batch.run(pending.constData() + i, count);
+            for (int lane = 0; lane < count; lane++)
+            {
+                int row = pending[i + lane];
+                if (uniform)
+                {
+                    for (int v = 1; v <= n; v++)
+                        distance[v] = bfs.distance(v - 1, lane);
+                }
+                else if (lanes)
+                {
+                    for (int v = 1; v <= n; v++)
+                        distance[v] = batch.distance(v, lane);
+                }
+                else
+                {
+                    graph.shortestPaths(row, distance);
+                }
+
+                uchar *line = matrix + qint64(row - 1) * n * elementSize;
+                if (elementSize == 4)
+                {
+                    qint32 *out = reinterpret_cast<qint32 *>(line);
+                    for (int v = 1; v <= n; v++)
+                        out[v - 1] = qint32(distance[v]);
+                }
+                else
+                {
+                    qint64 *out = reinterpret_cast<qint64 *>(line);
+                    for (int v = 1; v <= n; v++)
+                        out[v - 1] = distance[v];
+                }
+                flags[row - 1] = 1;
+            }
+        }
+    });
+
+    m_completedRows = int(std::count(flags, flags + n, uchar(1)));
+    m_file.unmap(data);
+    m_file.close();
+    return true;
+}
+
+bool AllPairsMatrix::load(const QString &fileName, const CsrGraph &graph)
+{
+    close();
+
+    m_file.setFileName(fileName);
+    if (!m_file.open(QIODevice::ReadOnly))
+        return false;
+
+    int n = graph.nodeCount();
+    ApspFileHeader header;
+    if (!readHeader(m_file, header) || header.nodeCount != n || header.fingerprint != graph.fingerprint()
+        || (header.elementSize != 4 && header.elementSize != 8)
+        || m_file.size() != fileSize(n, header.elementSize))
+    {
+        m_file.close();
+        return false;
+    }
+
+    const uchar *data = m_file.map(0, fileSize(n, header.elementSize));
+    if (!data)
+    {
+        m_file.close();
+        return false;
+    }
+    const uchar *flags = data + flagsOffset();
+    m_completedRows = int(std::count(flags, flags + n, uchar(1)));
+    if (m_completedRows != n)
+    {
+        close();
+        return false;
+    }
+
+    m_matrix = data + matrixOffset(n);
+    m_nodeCount = n;
+    m_elementSize = header.elementSize;
+    return true;
+}
+
+void AllPairsMatrix::close()
+{
+    // 关闭文件时 QFile 解除全部映射
+    if (m_file.isOpen())
+        m_file.close();
+    m_matrix = nullptr;
+    m_nodeCount = 0;
+    m_elementSize = 0;
+}
+
+bool AllPairsMatrix::path(const CsrGraph &graph, int source, int target, QVector<int> &result) const
+{
+    result.clear();
+    if (distance(source, target) >= CsrGraph::UNREACHABLE)
+        return false;
+
+    // 从终点向起点回溯：前驱 u 满足 d(s, u) + w(u, v) = d(s, v)（无向图中 v 的邻接边即指向 v 的边）
+    // 优先走正权边；零权边可能在等距节点之间往返，只走路径上尚未出现的节点
+    int node = target;
+    result.append(node);
+    while (node != source)
+    {
+        if (result.size() > m_nodeCount)
+            return false;
+
+        long d = distance(source, node);
+        int zeroStep = 0;
+        int step = 0;
+        for (int e = graph.offsets[node]; e < graph.offsets[node + 1] && step == 0; e++)
+        {
+            int u = graph.targets[e];
+            if (distance(source, u) + graph.weights[e] != d)
+                continue;
+            if (graph.weights[e] > 0)
+                step = u;
+            else if (zeroStep == 0 && !result.contains(u))
+                zeroStep = u;
+        }
+        node = step ? step : zeroStep;
+        if (node == 0)
+            return false;
+        result.append(node);
+    }
+    std::reverse(result.begin(), result.end());
+    return true;
+}
@@ -0,0 +1,59 @@
+#ifndef DIJKSTRA_APSP_H
+#define DIJKSTRA_APSP_H
+
+#include "dijkstra_csr.h"
+#include <QFile>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+// 全源最短路（APSP）距离矩阵，存放在内存映射文件中
+// 每个起点做一次单源搜索（全部边权相同时每 64 个起点一次位并行 BFS，否则每 8 个起点一次 SIMD 批量搜索），
+// 按线程并行（QtConcurrent），结果行直接写入映射内存；最大可能距离能用 32 位表示时每项 4 字节，否则 8 字节
+// 文件头之后是每行一个字节的完成标志，行写完后才置位，中断后再次 build 只计算未完成的行
+// 查询时只读映射，距离直接查表，路径沿起点所在行逐跳回溯
+class AllPairsMatrix
+{
+public:
+    AllPairsMatrix();
+    ~AllPairsMatrix();
+
+    // 计算距离矩阵写入 fileName；文件中已有同一张图的部分结果时从断点继续
+    // rowLimit > 0 时本次最多计算 rowLimit 行后返回（分段运行），threadCount <= 0 时使用全部核心
+    bool build(const CsrGraph &graph, const QString &fileName, int threadCount = 0, int rowLimit = 0);
+
+    // 只读映射已全部完成的矩阵文件；图的指纹不一致或未完成时返回 false
+    bool load(const QString &fileName, const CsrGraph &graph);
+    void close();
+    bool isLoaded() const { return m_matrix != nullptr; }
+
+    int nodeCount() const { return m_nodeCount; }
+    int elementSize() const { return m_elementSize; }
+    int completedRows() const { return m_completedRows; }
+    QString fileName() const { return m_file.fileName(); }
+
+    // 文件中的矩阵字节数
+    static qint64 matrixBytes(const CsrGraph &graph);
+
+    // source 到 target 的距离，不可达为 CsrGraph::UNREACHABLE；需已 load
+    long distance(int source, int target) const
+    {
+        qint64 index = qint64(source - 1) * m_nodeCount + (target - 1);
+        return m_elementSize == 4 ? long(reinterpret_cast<const qint32 *>(m_matrix)[index])
+                                  : long(reinterpret_cast<const qint64 *>(m_matrix)[index]);
+    }
+
+    // 由 source 所在行回溯 source 到 target 的路径（节点索引），不可达或无法回溯时返回 false
+    bool path(const CsrGraph &graph, int source, int target, QVector<int> &result) const;
+
+private:
+    static int chooseElementSize(const CsrGraph &graph);
+
+    QFile m_file;
+    const uchar *m_matrix;          // 映射的矩阵起始位置
+    int m_nodeCount;
+    int m_elementSize;
+    int m_completedRows;
+};
+
+#endif // DIJKSTRA_APSP_H
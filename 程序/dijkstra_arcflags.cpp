@@ -0,0 +1,225 @@
+#include "dijkstra_arcflags.h"
+#include <QtConcurrent>
+
+ArcFlags::ArcFlags()
+    : m_words(0)
+    , m_arcCount(0)
+    , m_regionCount(0)
+    , m_boundaryCount(0)
+{
+}
+
+bool ArcFlags::build(const CsrGraph &graph, int regionCount)
+{
+    clear();
+
+    // 反向搜索得到的最短路径树要求非负边权
+    int n = graph.nodeCount();
+    if (n == 0 || regionCount <= 0 || graph.minWeight < 0)
+        return false;
+
+    m_regionCount = qMin(regionCount, n);
+    partition(graph);
+
+    // 各区域的边界节点：有邻居位于其他区域
+    QVector<QVector<int>> boundary(m_regionCount);
+    for (int u = 1; u <= n; u++)
+    {
+        for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++)
+        {
+            if (m_region[graph.targets[e]] != m_region[u])
+            {
+                boundary[m_region[u]].append(u);
+                m_boundaryCount++;
+                break;
+            }
+        }
+    }
+
+    m_arcCount = graph.arcCount();
+    m_words = (m_arcCount + 63) / 64;
+    m_flags.fill(0, qint64(m_regionCount) * m_words);
+
+    QVector<int> regions;
+    for (int r = 0; r < m_regionCount; r++)
+        regions.append(r);
+
+    const QVector<int> &nodeRegion = m_region;
+    quint64 *flagData = m_flags.data();
+    int words = m_words;
+
+    QtConcurrent::blockingMap(regions, [&graph, &boundary, &nodeRegion, flagData, words, n](int r) {
+        quint64 *flags = flagData + qint64(r) * words;
+        auto set = [flags](int arc) { flags[arc >> 6] |= quint64(1) << (arc & 63); };
+
+        // 区域内部的边：终点在区域内的最短路径最后一段留在区域内
+        for (int u = 1; u <= n; u++)
+        {
+            if (nodeRegion[u] != r)
+                continue;
+            for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++)
+            {
+                if (nodeRegion[graph.targets[e]] == r)
+                    set(e);
+            }
+        }
+
+        // 从每个边界节点出发的最短路径树（无向图，即反向搜索树），
+        // 树边 u -> parent[u] 通往该边界节点
+        QVector<long> dist;
+        QVector<int> parent;
+        for (int i = 0; i < boundary[r].size(); i++)
+        {
+            graph.shortestPaths(boundary[r][i], dist, &parent);
+            for (int u = 1; u <= n; u++)
+            {
+                if (parent[u])
+                    set(graph.findArc(u, parent[u]));
+            }
+        }
+    });
+    return true;
+}
+
+void ArcFlags::partition(const CsrGraph &graph)
+{
+    int n = graph.nodeCount();
+    m_region.fill(0, n + 1);
+
+    // 度数为 1 的节点与其唯一邻居同区域，不会成为边界节点；只对其余节点划分
+    QVector<int> attach(n + 1, 0);
+    for (int u = 1; u <= n; u++)
+    {
+        int neighbor = 0, degree = 0;
+        for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++)
+        {
+            if (graph.targets[e] != u)
+            {
+                neighbor = graph.targets[e];
+                degree++;
+            }
+        }
+        if (degree == 1 && graph.degree(neighbor) > 1)
+            attach[u] = neighbor;
+    }
+
+    // 递归二分：在子图内按 BFS 顺序（从伪外围节点开始）切成两段，
+    // 两段节点数与分得的区域数成比例；用显式栈代替递归
+    QVector<int> inSet(n + 1, 0), visited(n + 1, 0);
+    int setStamp = 0, visitStamp = 0;
+    QVector<int> queue;
+
+    // 在当前子图内从 source 开始 BFS，追加到 queue
+    auto bfs = [&](int source) {
+        int head = queue.size();
+        queue.append(source);
+        visited[source] = visitStamp;
+        for (; head < queue.size(); head++)
+        {
+            int u = queue[head];
+            for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++)
+            {
+                int v = graph.targets[e];
+                if (inSet[v] == setStamp && visited[v] != visitStamp)
+                {
+                    visited[v] = visitStamp;
+                    queue.append(v);
+                }
+            }
+        }
+    };
+
+    struct Part
+    {
+        QVector<int> nodes;
+        int firstRegion;
+        int regionCount;
+    };
+    QVector<Part> stack;
+    QVector<int> core;
+    for (int v = 1; v <= n; v++)
+    {
+        if (attach[v] == 0)
+            core.append(v);
+    }
+    stack.append(Part{ core, 0, m_regionCount });
+
+    while (!stack.isEmpty())
+    {
+        Part part = stack.takeLast();
+        if (part.regionCount == 1 || part.nodes.size() <= 1)
+        {
+            for (int i = 0; i < part.nodes.size(); i++)
+                m_region[part.nodes[i]] = part.firstRegion;
+            continue;
+        }
+
+        setStamp++;
+        for (int i = 0; i < part.nodes.size(); i++)
+            inSet[part.nodes[i]] = setStamp;
+
+        // 伪外围节点：从任一节点 BFS 最后到达的节点
+        visitStamp++;
+        queue.clear();
+        bfs(part.nodes[0]);
+        int start = queue.last();
+
+        // 按 BFS 顺序排列，不连通的部分依次接在后面
+        visitStamp++;
+        queue.clear();
+        bfs(start);
+        for (int i = 0; i < part.nodes.size(); i++)
+        {
+            if (visited[part.nodes[i]] != visitStamp)
+                bfs(part.nodes[i]);
+        }
+
+        int leftRegions = part.regionCount / 2;
+        int leftSize = int(qint64(queue.size()) * leftRegions / part.regionCount);
+        stack.append(Part{ queue.mid(0, leftSize), part.firstRegion, leftRegions });
+        stack.append(Part{ queue.mid(leftSize), part.firstRegion + leftRegions,
+                           part.regionCount - leftRegions });
+    }
+
+    for (int u = 1; u <= n; u++)
+    {
+        if (attach[u])
+            m_region[u] = m_region[attach[u]];
+    }
+}
+
+void ArcFlags::clear()
+{
+    m_region.clear();
+    m_flags.clear();
+    m_flags.squeeze();
+    m_words = 0;
+    m_arcCount = 0;
+    m_regionCount = 0;
+    m_boundaryCount = 0;
+}
+
+double ArcFlags::flaggedRatio() const
+{
+    if (m_flags.isEmpty())
+        return 0.0;
+    // 末尾字中的多余位始终为 0，不影响计数
+    qint64 set = 0;
+    for (int i = 0; i < m_flags.size(); i++)
+    {
+        quint64 word = m_flags[i];
+        while (word)
+        {
+            word &= word - 1;
+            set++;
+        }
+    }
+    qint64 total = qint64(m_regionCount) * m_arcCount;
+    return total > 0 ? double(set) / total : 0.0;
+}
+
+qint64 ArcFlags::memoryUsage() const
+{
+    return qint64(m_region.capacity()) * sizeof(int)
+         + qint64(m_flags.capacity()) * sizeof(quint64);
+}
@@ -0,0 +1,51 @@
+#ifndef DIJKSTRA_ARCFLAGS_H
+#define DIJKSTRA_ARCFLAGS_H
+
+#include "dijkstra_csr.h"
+#include <QVector>
+#include <QtGlobal>
+
+// 弧标志（Arc Flags）预处理
+// 把节点划分为 R 个区域，为每条有向边记录一个区域位集：
+// 第 r 位为 1 表示该边位于某条通往区域 r 的最短路径上
+// 查询时只沿目标所在区域的标志位为 1 的边扩展
+// 标志位按区域存放：每个区域一个与 CSR 边下标对齐的位数组，
+// 查询只读取目标区域的位数组，预处理时各区域由不同线程独立写入
+class ArcFlags
+{
+public:
+    ArcFlags();
+
+    // 划分区域并计算标志；每个区域的边界节点各做一次反向搜索，按区域并行（QtConcurrent）
+    // 存在负边权时返回 false
+    bool build(const CsrGraph &graph, int regionCount);
+
+    void clear();
+    bool isEmpty() const { return m_region.isEmpty(); }
+
+    int regionCount() const { return m_regionCount; }
+    int region(int node) const { return m_region[node]; }
+    int boundaryNodeCount() const { return m_boundaryCount; }
+
+    // 区域 region 的标志位数组（按 CSR 边下标）
+    const quint64 *flags(int region) const { return m_flags.constData() + qint64(region) * m_words; }
+    static bool isSet(const quint64 *flags, int arc) { return (flags[arc >> 6] >> (arc & 63)) & 1; }
+
+    // 标志位为 1 的比例，反映剪枝效果
+    double flaggedRatio() const;
+
+    // 占用内存（字节）
+    qint64 memoryUsage() const;
+
+private:
+    void partition(const CsrGraph &graph);
+
+    QVector<int> m_region;          // 节点所属区域（0..R-1）
+    QVector<quint64> m_flags;       // R × m_words，按区域存放
+    int m_words;                    // 每个区域的位数组字数
+    int m_arcCount;
+    int m_regionCount;
+    int m_boundaryCount;
+};
+
+#endif // DIJKSTRA_ARCFLAGS_H
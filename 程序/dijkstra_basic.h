@@ -0,0 +1,140 @@
+#ifndef DIJKSTRA_BASIC_H
+#define DIJKSTRA_BASIC_H
+
+#include "dijkstra_csr.h"
+#include "dijkstra_workspace.h"
+#include <type_traits>
+
+// BasicDijkstra 读取的 CSR 图（不持有数据）：节点 u 的边位于 [offsets[u], offsets[u + 1])，节点索引 1..nodeCount
+template <typename Weight, typename Index>
+struct CsrView
+{
+    int nodeCount = 0;
+    const int *offsets = nullptr;
+    const Index *targets = nullptr;
+    const Weight *weights = nullptr;
+};
+
+inline CsrView<long, int> csrView(const CsrGraph &graph)
+{
+    CsrView<long, int> view;
+    view.nodeCount = graph.nodeCount();
+    view.offsets = graph.offsets.constData();
+    view.targets = graph.targets.constData();
+    view.weights = graph.weights.constData();
+    return view;
+}
+
+// 不观察搜索过程，调用是空的内联函数，编译后不留痕迹
+struct NullSearchObserver
+{
+    void settled(int, long) {}
+    void improved(int, long) {}
+};
+
+// 单源 Dijkstra 主循环的编译期组合：
+//   Weight/Index   边权（距离）与节点索引的类型，如较小的图可用 32 位边权减少内存带宽
+//   TrackPaths     记录回溯用的前驱；关闭时只算距离
+//   TrackTies      记录全部等长的前驱（前驱列表，搜索状态为 SearchWorkspace），否则每个节点只记一个前驱
+//   Observer       节点确定（settled）和距离变小（improved）时的回调，如动画；NullSearchObserver 表示不观察
+// 关闭的功能由模板参数在编译期去掉，主循环中没有逐次的运行期判断
+// Dijkstra::getDistance 使用 <long, int, true, true>（有动画时带回调观察者），query 使用 <long, int, true, false>，
+// queryDistance 使用 <long, int, false, false>
+template <typename Weight, typename Index, bool TrackPaths, bool TrackTies, typename Observer = NullSearchObserver>
+class BasicDijkstra
+{
+    static_assert(TrackPaths || !TrackTies, "记录等长前驱须同时记录路径");
+    static_assert(!TrackTies || (std::is_same<Weight, long>::value && std::is_same<Index, int>::value),
+                  "前驱列表保存在 SearchWorkspace 中，只支持 long 距离和 int 索引");
+
+public:
+    typedef typename std::conditional<TrackTies, SearchWorkspace,
+                                      CompactSearchWorkspace<Weight, Index, TrackPaths>>::type Workspace;
+
+    BasicDijkstra(const CsrView<Weight, Index> &graph, Workspace &state, Observer observer = Observer())
+        : m_graph(graph)
+        , m_state(state)
+        , m_observer(observer)
+        , m_settledCount(0)
+    {
+    }
+
+    // 从 source 开始新的搜索；搜索状态由调用方先复位（resize / reset）
+    template <typename Queue>
+    void start(Queue &queue, Index source)
+    {
+        queue.reset(m_graph.nodeCount);
+        m_state.entry(source).distance = 0;
+        queue.push(source, 0);
+    }
+
+    // 继续搜索，直到 target 确定（其邻边已松弛）或队列为空；target 为 0 时搜索整个连通分量
+    // 队列保留在调用方，之后可再次调用继续同一次搜索。返回是否已遍历整个连通分量
+    template <typename Queue>
+    bool run(Queue &queue, Index target = 0)
+    {
+        const int *offsets = m_graph.offsets;
+        const Index *targets = m_graph.targets;
+        const Weight *weights = m_graph.weights;
+
+        while (!queue.isEmpty())
+        {
+            long key;
+            Index minIndex = Index(queue.pop(key));
+            Weight minDist = Weight(key);
+
+            // 惰性删除的队列可能残留已确定节点的过期条目
+            auto &settled = m_state.entry(minIndex);
+            if (settled.visited)
+                continue;
+            settled.visited = true;
+            m_settledCount++;
+            m_observer.settled(minIndex, minDist);
+
+            for (int e = offsets[minIndex]; e < offsets[minIndex + 1]; e++)
+            {
+                Index adjIndex = targets[e];
+                auto &adj = m_state.entry(adjIndex);
+                if (adj.visited)
+                    continue;
+
+                Weight newDist = minDist + weights[e];
+                if (newDist < adj.distance)
+                {
+                    adj.distance = newDist;
+                    if constexpr (TrackTies)
+                    {
+                        adj.parents.clear();
+                        adj.parents.append(minIndex);
+                    }
+                    else if constexpr (TrackPaths)
+                    {
+                        adj.parent = minIndex;
+                    }
+                    queue.push(adjIndex, newDist);
+                    m_observer.improved(adjIndex, newDist);
+                }
+                else if constexpr (TrackTies)
+                {
+                    if (newDist == adj.distance && !adj.parents.contains(minIndex))
+                        adj.parents.append(minIndex);
+                }
+            }
+
+            if (minIndex == target)
+                return queue.isEmpty();
+        }
+        return true;
+    }
+
+    // 本对象确定（出队）的节点数
+    int settledCount() const { return m_settledCount; }
+
+private:
+    CsrView<Weight, Index> m_graph;
+    Workspace &m_state;
+    Observer m_observer;
+    int m_settledCount;
+};
+
+#endif // DIJKSTRA_BASIC_H
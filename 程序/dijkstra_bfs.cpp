@@ -0,0 +1,93 @@
+#include "dijkstra_bfs.h"
+#include <QtAlgorithms>
+
+MultiSourceBfs::MultiSourceBfs()
+    : m_weight(0)
+    , m_levelCount(0)
+    , m_expanded(0)
+{
+}
+
+void MultiSourceBfs::run(const CsrGraph &graph, const int *sources, int count, const QVector<int> &slot,
+                         int slotCount)
+{
+    const int *offsets = graph.offsets.constData();
+    const int *targets = graph.targets.constData();
+    int n = graph.nodeCount();
+
+    m_weight = graph.uniformWeight();
+    m_seen.fill(0, n + 1);
+    m_frontier.fill(0, n + 1);
+    m_next.fill(0, n + 1);
+    m_levels.fill(-1, qint64(slotCount) * BATCH);
+    m_current.clear();
+    m_touched.clear();
+    m_levelCount = 0;
+    m_expanded = 0;
+
+    quint64 *seen = m_seen.data();
+    quint64 *frontier = m_frontier.data();
+    quint64 *next = m_next.data();
+    qint32 *levels = m_levels.data();
+
+    // 尚未到达的（终点, 起点）对数，为 0 时提前结束
+    qint64 remaining = qint64(slotCount) * count;
+    auto record = [&](int node, quint64 lanes, int level) {
+        int index = slot[node];
+        if (index < 0)
+            return;
+        remaining -= qPopulationCount(lanes);
+        for (; lanes; lanes &= lanes - 1)
+            levels[qint64(index) * BATCH + qCountTrailingZeroBits(lanes)] = level;
+    };
+
+    for (int i = 0; i < count; i++)
+    {
+        int s = sources[i];
+        quint64 lane = quint64(1) << i;
+        if (!frontier[s])
+            m_current.append(s);
+        seen[s] |= lane;
+        frontier[s] |= lane;
+    }
+    for (int i = 0; i < m_current.size(); i++)
+        record(m_current[i], frontier[m_current[i]], 0);
+
+    int level = 0;
+    while (!m_current.isEmpty() && remaining > 0)
+    {
+        level++;
+        for (int i = 0; i < m_current.size(); i++)
+        {
+            int u = m_current[i];
+            quint64 lanes = frontier[u];
+            frontier[u] = 0;
+            for (int e = offsets[u]; e < offsets[u + 1]; e++)
+            {
+                int v = targets[e];
+                // 只传递 v 尚未见过的起点
+                quint64 fresh = lanes & ~seen[v];
+                if (!fresh)
+                    continue;
+                if (!next[v])
+                    m_touched.append(v);
+                next[v] |= fresh;
+            }
+        }
+        m_expanded += m_current.size();
+        m_current.clear();
+
+        for (int i = 0; i < m_touched.size(); i++)
+        {
+            int v = m_touched[i];
+            quint64 lanes = next[v];
+            next[v] = 0;
+            seen[v] |= lanes;
+            frontier[v] = lanes;
+            m_current.append(v);
+            record(v, lanes, level);
+        }
+        m_touched.clear();
+    }
+    m_levelCount = level;
+}
@@ -0,0 +1,47 @@
+#ifndef DIJKSTRA_BFS_H
+#define DIJKSTRA_BFS_H
+
+#include "dijkstra_csr.h"
+#include <QVector>
+#include <QtGlobal>
+
+// 全部边权相同的图（CsrGraph::uniformWeight() > 0）上的位并行多源 BFS
+// 一次最多 64 个起点，每个节点用一个 64 位字记录已到达它的起点集合，另一个字记录本层新到达的起点；
+// 每层只扩展本层有新起点到达的节点，一条边的松弛对 64 个起点同时生效
+// 只记录 slot 中标记的节点（终点）的层数，全部终点被全部起点到达后提前结束
+// 距离 = 层数 × 边权
+class MultiSourceBfs
+{
+public:
+    static const int BATCH = 64;
+
+    MultiSourceBfs();
+
+    // 从 sources[0..count) 同时出发（count <= BATCH，节点索引 1..n）
+    // slot[v] 为节点 v 的结果位置（0..slotCount-1），不需要记录的节点为 -1
+    void run(const CsrGraph &graph, const int *sources, int count, const QVector<int> &slot, int slotCount);
+
+    // 第 lane 个起点到结果位置 slotIndex 的节点的距离，不可达为 CsrGraph::UNREACHABLE
+    long distance(int slotIndex, int lane) const
+    {
+        qint32 level = m_levels[qint64(slotIndex) * BATCH + lane];
+        return level < 0 ? CsrGraph::UNREACHABLE : level * m_weight;
+    }
+
+    // 最近一次运行的层数与扩展过的节点数
+    int levelCount() const { return m_levelCount; }
+    qint64 expandedCount() const { return m_expanded; }
+
+private:
+    QVector<quint64> m_seen;        // 已到达各节点的起点集合
+    QVector<quint64> m_frontier;    // 本层新到达各节点的起点集合
+    QVector<quint64> m_next;        // 下一层候选
+    QVector<int> m_current;         // 本层 m_frontier 非零的节点
+    QVector<int> m_touched;         // 下一层 m_next 非零的节点
+    QVector<qint32> m_levels;       // slotCount × BATCH，未到达为 -1
+    long m_weight;
+    int m_levelCount;
+    qint64 m_expanded;
+};
+
+#endif // DIJKSTRA_BFS_H
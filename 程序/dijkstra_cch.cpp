@@ -0,0 +1,441 @@
+#include "dijkstra_cch.h"
+#include <QPair>
+#include <algorithm>
+
+namespace {
+
+// 子图规模不超过该值时不再剖分，直接依次编号
+const int DISSECTION_LEAF_SIZE = 8;
+
+// 基于 BFS 分层的嵌套剖分
+// 从伪外围节点出发做 BFS，取中位节点所在层中与下一层相邻的节点作为分隔集；
+// 两侧子图分得较低的等级并继续剖分，分隔集取该区间内最高的等级
+class Dissection
+{
+public:
+    explicit Dissection(const CsrGraph &graph)
+        : m_graph(graph)
+        , m_inSet(graph.nodeCount() + 1, 0)
+        , m_visited(graph.nodeCount() + 1, 0)
+        , m_level(graph.nodeCount() + 1, 0)
+        , m_setStamp(0)
+        , m_visitStamp(0)
+    {
+    }
+
+    // 返回等级 -> 节点（下标 1..n）
+    QVector<int> order()
+    {
+        int n = m_graph.nodeCount();
+        QVector<int> result(n + 1, 0);
+
+        // 待剖分的子图及其等级区间起点，用显式栈代替递归
+        struct Task
+        {
+            QVector<int> nodes;
+            int first;
+        };
+        QVector<Task> stack;
+        QVector<int> all;
+        all.reserve(n);
+        for (int v = 1; v <= n; v++)
+            all.append(v);
+        stack.append(Task{ all, 1 });
+
+        while (!stack.isEmpty())
+        {
+            Task task = stack.takeLast();
+            const QVector<int> &nodes = task.nodes;
+            if (nodes.size() <= DISSECTION_LEAF_SIZE)
+            {
+                for (int i = 0; i < nodes.size(); i++)
+                    result[task.first + i] = nodes[i];
+                continue;
+            }
+
+            m_setStamp++;
+            for (int i = 0; i < nodes.size(); i++)
+                m_inSet[nodes[i]] = m_setStamp;
+
+            bfs(nodes[0]);
+            if (m_queue.size() < nodes.size())
+            {
+                // 子图不连通：第一个连通分量与其余部分分开处理，无需分隔集
+                QVector<int> rest;
+                for (int i = 0; i < nodes.size(); i++)
+                {
+                    if (m_visited[nodes[i]] != m_visitStamp)
+                        rest.append(nodes[i]);
+                }
+                stack.append(Task{ m_queue, task.first });
+                stack.append(Task{ rest, task.first + int(m_queue.size()) });
+                continue;
+            }
+
+            // 伪外围节点：上一次 BFS 最后到达的节点
+            bfs(m_queue.last());
+
+            int maxLevel = m_level[m_queue.last()];
+            int separatorLevel = qMin(m_level[m_queue[m_queue.size() / 2]], maxLevel - 1);
+
+            QVector<int> lower, upper, separator;
+            for (int i = 0; i < m_queue.size(); i++)
+            {
+                int v = m_queue[i];
+                int level = m_level[v];
+                if (level < separatorLevel)
+                    lower.append(v);
+                else if (level > separatorLevel)
+                    upper.append(v);
+                else if (touchesLevel(v, separatorLevel + 1))
+                    separator.append(v);
+                else
+                    lower.append(v);
+            }
+
+            int first = task.first;
+            int top = first + int(lower.size() + upper.size());
+            for (int i = 0; i < separator.size(); i++)
+                result[top + i] = separator[i];
+            stack.append(Task{ lower, first });
+            stack.append(Task{ upper, first + int(lower.size()) });
+        }
+        return result;
+    }
+
+private:
+    // 在当前子图内做 BFS，m_queue 按访问顺序记录到达的节点
+    void bfs(int source)
+    {
+        m_visitStamp++;
+        m_queue.clear();
+        m_queue.append(source);
+        m_visited[source] = m_visitStamp;
+        m_level[source] = 0;
+        for (int head = 0; head < m_queue.size(); head++)
+        {
+            int u = m_queue[head];
+            for (int e = m_graph.offsets[u]; e < m_graph.offsets[u + 1]; e++)
+            {
+                int v = m_graph.targets[e];
+                if (m_inSet[v] != m_setStamp || m_visited[v] == m_visitStamp)
+                    continue;
+                m_visited[v] = m_visitStamp;
+                m_level[v] = m_level[u] + 1;
+                m_queue.append(v);
+            }
+        }
+    }
+
+    bool touchesLevel(int u, int level) const
+    {
+        for (int e = m_graph.offsets[u]; e < m_graph.offsets[u + 1]; e++)
+        {
+            int v = m_graph.targets[e];
+            if (m_inSet[v] == m_setStamp && m_level[v] == level)
+                return true;
+        }
+        return false;
+    }
+
+    const CsrGraph &m_graph;
+    QVector<int> m_inSet;       // 等于 m_setStamp 时节点属于当前子图
+    QVector<int> m_visited;     // 等于 m_visitStamp 时节点已被当前 BFS 访问
+    QVector<int> m_level;       // BFS 层号
+    QVector<int> m_queue;
+    int m_setStamp;
+    int m_visitStamp;
+};
+
+} // namespace
+
+CustomizableCH::CustomizableCH()
+    : m_treeHeight(0)
+{
+}
+
+bool CustomizableCH::build(const CsrGraph &graph)
+{
+    clear();
+
+    int n = graph.nodeCount();
+    if (n == 0 || graph.minWeight < 0)
+        return false;
+
+    computeOrder(graph);
+    buildTopology(graph);
+
+    for (int d = 0; d < 2; d++)
+    {
+        m_distance[d].fill(CsrGraph::UNREACHABLE, n + 1);
+        m_parent[d].fill(0, n + 1);
+    }
+    return customize(graph);
+}
+
+void CustomizableCH::computeOrder(const CsrGraph &graph)
+{
+    int n = graph.nodeCount();
+    Dissection dissection(graph);
+    m_node = dissection.order();
+    m_rank.fill(0, n + 1);
+    for (int r = 1; r <= n; r++)
+        m_rank[m_node[r]] = r;
+}
+
+void CustomizableCH::buildTopology(const CsrGraph &graph)
+{
+    int n = graph.nodeCount();
+
+    // 按等级收缩：x 的向上邻居两两相连；由弦图性质，只需把它们并入
+    // 消除树父节点（等级最低的向上邻居）的邻接表，父节点收缩时再继续传递
+    QVector<QVector<int>> up(n + 1);
+    for (int u = 1; u <= n; u++)
+    {
+        for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++)
+        {
+            int ru = m_rank[u];
+            int rv = m_rank[graph.targets[e]];
+            if (ru < rv)
+                up[ru].append(rv);
+        }
+    }
+
+    m_elimParent.fill(0, n + 1);
+    m_upOffsets.resize(n + 2);
+    m_upOffsets[0] = 0;
+    for (int x = 1; x <= n; x++)
+    {
+        QVector<int> &arcs = up[x];
+        std::sort(arcs.begin(), arcs.end());
+        arcs.erase(std::unique(arcs.begin(), arcs.end()), arcs.end());
+
+        m_upOffsets[x] = m_upTargets.size();
+        m_upTargets.append(arcs);
+        if (!arcs.isEmpty())
+        {
+            int parent = arcs[0];
+            m_elimParent[x] = parent;
+            for (int i = 1; i < arcs.size(); i++)
+                up[parent].append(arcs[i]);
+        }
+        arcs.clear();
+        arcs.squeeze();
+    }
+    m_upOffsets[n + 1] = m_upTargets.size();
+
+    // 父节点等级总是更高，从高到低即可求出深度
+    QVector<int> depth(n + 1, 1);
+    m_treeHeight = 0;
+    for (int x = n; x >= 1; x--)
+    {
+        if (m_elimParent[x])
+            depth[x] = depth[m_elimParent[x]] + 1;
+        m_treeHeight = qMax(m_treeHeight, depth[x]);
+    }
+
+    // 原图边到向上图边的映射，重新定制时直接按下标写入边权
+    m_inputArcs.resize(graph.arcCount());
+    for (int u = 1; u <= n; u++)
+    {
+        for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++)
+        {
+            int ru = m_rank[u];
+            int rv = m_rank[graph.targets[e]];
+            m_inputArcs[e] = (ru == rv) ? -1 : findUpArc(qMin(ru, rv), qMax(ru, rv));
+        }
+    }
+}
+
+bool CustomizableCH::customize(const CsrGraph &graph)
+{
+    // 向上查询依赖非负边权；改成负边权时拒绝定制
+    int n = nodeCount();
+    if (n == 0 || graph.nodeCount() != n || graph.arcCount() != m_inputArcs.size() || graph.minWeight < 0)
+        return false;
+
+    m_upWeights.fill(CsrGraph::UNREACHABLE, m_upTargets.size());
+    m_upMiddles.fill(0, m_upTargets.size());
+
+    const long *inputWeights = graph.weights.constData();
+    long *weights = m_upWeights.data();
+    int *middles = m_upMiddles.data();
+    for (int e = 0; e < m_inputArcs.size(); e++)
+    {
+        int arc = m_inputArcs[e];
+        if (arc >= 0 && inputWeights[e] < weights[arc])
+            weights[arc] = inputWeights[e];
+    }
+
+    // 下三角形：x < a < b，边 (a, b) 必然存在；
+    // x 与 a 的向上邻居表都按等级升序，用一次归并找到所有 (a, b)
+    const int *offsets = m_upOffsets.constData();
+    const int *targets = m_upTargets.constData();
+    for (int x = 1; x <= n; x++)
+    {
+        for (int i = offsets[x]; i < offsets[x + 1]; i++)
+        {
+            long wa = weights[i];
+            if (wa >= CsrGraph::UNREACHABLE)
+                continue;
+            int a = targets[i];
+            int k = offsets[a];
+            for (int j = i + 1; j < offsets[x + 1]; j++)
+            {
+                long wb = weights[j];
+                if (wb >= CsrGraph::UNREACHABLE)
+                    continue;
+                int b = targets[j];
+                while (targets[k] < b)
+                    k++;
+                if (wa + wb < weights[k])
+                {
+                    weights[k] = wa + wb;
+                    middles[k] = x;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void CustomizableCH::clear()
+{
+    m_rank.clear();
+    m_node.clear();
+    m_elimParent.clear();
+    m_upOffsets.clear();
+    m_upTargets.clear();
+    m_inputArcs.clear();
+    m_upWeights.clear();
+    m_upMiddles.clear();
+    m_treeHeight = 0;
+    for (int d = 0; d < 2; d++)
+    {
+        m_distance[d].clear();
+        m_parent[d].clear();
+    }
+}
+
+qint64 CustomizableCH::memoryUsage() const
+{
+    qint64 bytes = qint64(m_rank.capacity() + m_node.capacity() + m_elimParent.capacity()) * sizeof(int)
+                 + qint64(m_upOffsets.capacity() + m_upTargets.capacity()) * sizeof(int)
+                 + qint64(m_inputArcs.capacity()) * sizeof(int)
+                 + qint64(m_upWeights.capacity()) * sizeof(long)
+                 + qint64(m_upMiddles.capacity()) * sizeof(int);
+    for (int d = 0; d < 2; d++)
+        bytes += qint64(m_distance[d].capacity()) * sizeof(long) + qint64(m_parent[d].capacity()) * sizeof(int);
+    return bytes;
+}
+
+long CustomizableCH::query(int source, int target, QVector<int> *path, int *settled)
+{
+    const int roots[2] = { m_rank[source], m_rank[target] };
+    const int *offsets = m_upOffsets.constData();
+    const int *targets = m_upTargets.constData();
+    const long *weights = m_upWeights.constData();
+
+    // 向上搜索空间恰为消除树上的祖先，按等级从低到高依次扫描即可
+    int scanned = 0;
+    for (int d = 0; d < 2; d++)
+    {
+        long *distance = m_distance[d].data();
+        int *parent = m_parent[d].data();
+        distance[roots[d]] = 0;
+        for (int x = roots[d]; x; x = m_elimParent[x])
+        {
+            scanned++;
+            long dx = distance[x];
+            if (dx >= CsrGraph::UNREACHABLE)
+                continue;
+            for (int e = offsets[x]; e < offsets[x + 1]; e++)
+            {
+                int y = targets[e];
+                long nd = dx + weights[e];
+                if (nd < distance[y])
+                {
+                    distance[y] = nd;
+                    parent[y] = x;
+                }
+            }
+        }
+    }
+
+    // 两条祖先路径的公共部分上取两侧距离之和的最小值
+    long best = CsrGraph::UNREACHABLE;
+    int meet = 0;
+    for (int x = roots[0]; x; x = m_elimParent[x])
+    {
+        long forward = m_distance[0][x];
+        long backward = m_distance[1][x];
+        if (forward < CsrGraph::UNREACHABLE && backward < CsrGraph::UNREACHABLE && forward + backward < best)
+        {
+            best = forward + backward;
+            meet = x;
+        }
+    }
+
+    if (path && best < CsrGraph::UNREACHABLE)
+    {
+        QVector<int> coarse;
+        for (int x = meet; x != roots[0]; x = m_parent[0][x])
+            coarse.append(x);
+        coarse.append(roots[0]);
+        std::reverse(coarse.begin(), coarse.end());
+        for (int x = meet; x != roots[1]; )
+        {
+            x = m_parent[1][x];
+            coarse.append(x);
+        }
+
+        path->clear();
+        path->append(source);
+        for (int i = 1; i < coarse.size(); i++)
+            unpackEdge(coarse[i - 1], coarse[i], *path);
+    }
+
+    for (int d = 0; d < 2; d++)
+    {
+        for (int x = roots[d]; x; x = m_elimParent[x])
+        {
+            m_distance[d][x] = CsrGraph::UNREACHABLE;
+            m_parent[d][x] = 0;
+        }
+    }
+
+    if (settled)
+        *settled = scanned;
+    return best;
+}
+
+int CustomizableCH::findUpArc(int from, int to) const
+{
+    const int *first = m_upTargets.constData() + m_upOffsets[from];
+    const int *last = m_upTargets.constData() + m_upOffsets[from + 1];
+    const int *it = std::lower_bound(first, last, to);
+    return (it != last && *it == to) ? int(it - m_upTargets.constData()) : -1;
+}
+
+void CustomizableCH::unpackEdge(int from, int to, QVector<int> &path) const
+{
+    // 参数为等级；依次追加 from 之后直到 to 的原图节点
+    QVector<QPair<int, int>> stack;
+    stack.append(qMakePair(from, to));
+    while (!stack.isEmpty())
+    {
+        QPair<int, int> edge = stack.takeLast();
+        int a = edge.first;
+        int b = edge.second;
+        int middle = m_upMiddles[findUpArc(qMin(a, b), qMax(a, b))];
+        if (middle == 0)
+        {
+            path.append(m_node[b]);
+        }
+        else
+        {
+            stack.append(qMakePair(middle, b));
+            stack.append(qMakePair(a, middle));
+        }
+    }
+}
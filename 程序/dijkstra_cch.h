@@ -0,0 +1,66 @@
+#ifndef DIJKSTRA_CCH_H
+#define DIJKSTRA_CCH_H
+
+#include "dijkstra_csr.h"
+#include <QVector>
+#include <QtGlobal>
+
+// 可定制收缩层次（Customizable Contraction Hierarchies）
+// 预处理分为两步：
+//   1. 与边权无关的部分：嵌套剖分（nested dissection）确定收缩顺序，
+//      按顺序收缩全部节点并补全为弦图，得到固定的向上图拓扑
+//   2. 定制（customize）：把当前边权写入向上图，再按等级从低到高处理下三角形
+//      w(a, b) = min(w(a, b), w(x, a) + w(x, b))，只需线性扫描，无需任何搜索
+// 边权改变而拓扑不变时只需重新定制
+// 查询沿消除树（每个节点的父节点为其等级最低的向上邻居）向根扫描，无需优先队列
+class CustomizableCH
+{
+public:
+    CustomizableCH();
+
+    // 计算收缩顺序与向上图拓扑，并按 graph 的边权完成一次定制
+    bool build(const CsrGraph &graph);
+
+    // 重新应用边权；graph 的拓扑必须与 build 时一致，存在负边权时同样返回 false
+    bool customize(const CsrGraph &graph);
+
+    void clear();
+    bool isEmpty() const { return m_rank.isEmpty(); }
+
+    int nodeCount() const { return m_rank.isEmpty() ? 0 : int(m_rank.size()) - 1; }
+    int arcCount() const { return int(m_upTargets.size()); }    // 向上图边数（含补全边）
+    int treeHeight() const { return m_treeHeight; }             // 消除树高度
+    int rank(int node) const { return m_rank[node]; }
+
+    // source 到 target 的最短距离，不可达返回 CsrGraph::UNREACHABLE
+    // path 非空时写入起点到终点的原图节点索引，settled 非空时返回扫描的节点数
+    long query(int source, int target, QVector<int> *path = nullptr, int *settled = nullptr);
+
+    // 占用内存（字节）
+    qint64 memoryUsage() const;
+
+private:
+    void computeOrder(const CsrGraph &graph);
+    void buildTopology(const CsrGraph &graph);
+    int findUpArc(int from, int to) const;
+    void unpackEdge(int from, int to, QVector<int> &path) const;
+
+    // 以下数组除 m_rank、m_inputArcs 外均按等级（1..n）索引
+    QVector<int> m_rank;            // 节点 -> 等级
+    QVector<int> m_node;            // 等级 -> 节点
+    QVector<int> m_elimParent;      // 消除树父节点，根为 0
+    QVector<int> m_upOffsets;       // 向上图（CSR），每个节点的边按目标等级升序
+    QVector<int> m_upTargets;
+    QVector<int> m_inputArcs;       // 原图 CSR 边 -> 向上图边，自环为 -1
+    int m_treeHeight;
+
+    // 定制结果
+    QVector<long> m_upWeights;
+    QVector<int> m_upMiddles;       // 取得最小值的下三角形顶点（等级），原始边为 0
+
+    // 查询工作区（0：正向，1：反向），查询结束时沿消除树路径复位
+    QVector<long> m_distance[2];
+    QVector<int> m_parent[2];
+};
+
+#endif // DIJKSTRA_CCH_H
@@ -0,0 +1,453 @@
+#include "dijkstra_ch.h"
+#include <QPair>
+#include <algorithm>
+
+namespace {
+
+// 见证搜索扫描的边数上限：收缩时较大，估算优先级时较小
+// 以边数而非节点数计，避免搜索经过高度数节点时代价失控；
+// 搜索提前结束只会多加捷径，不影响正确性
+const int WITNESS_SCAN_LIMIT = 2000;
+const int SIMULATE_SCAN_LIMIT = 500;
+
+// 估算优先级时，度数超过该值的节点不做见证搜索，直接以邻居对数作为捷径数上界
+// 这类节点无论如何都会排在后面，等邻居大多收缩后再精确计算
+const int SIMULATE_DEGREE_LIMIT = 64;
+
+// 收缩过程中的动态邻接边
+struct DynArc
+{
+    int target;
+    long weight;
+    int middle;     // 捷径的中间节点，原始边为 0
+};
+
+// 收缩过程：维护剩余图并执行见证搜索
+class Contractor
+{
+public:
+    explicit Contractor(const CsrGraph &graph)
+        : m_nodeCount(graph.nodeCount())
+        , m_adj(graph.nodeCount() + 1)
+        , m_contracted(graph.nodeCount() + 1, false)
+        , m_deletedNeighbors(graph.nodeCount() + 1, 0)
+        , m_dist(graph.nodeCount() + 1, CsrGraph::UNREACHABLE)
+    {
+        for (int u = 1; u <= m_nodeCount; u++)
+        {
+            for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++)
+            {
+                if (graph.targets[e] != u)
+                    addArc(u, graph.targets[e], graph.weights[e], 0);
+            }
+        }
+        m_heap.reset(m_nodeCount);
+    }
+
+    // 收缩 v（simulate 为 true 时只统计所需捷径数），返回捷径数
+    int contract(int v, bool simulate)
+    {
+        collectNeighbors(v);
+        int degree = m_neighbors.size();
+        if (simulate && degree > SIMULATE_DEGREE_LIMIT)
+            return degree * (degree - 1) / 2;
+
+        int limit = simulate ? SIMULATE_SCAN_LIMIT : WITNESS_SCAN_LIMIT;
+        int shortcuts = 0;
+
+        for (int i = 0; i < m_neighbors.size(); i++)
+        {
+            const DynArc &in = m_neighbors[i];
+            long maxVia = -1;
+            for (int j = i + 1; j < m_neighbors.size(); j++)
+                maxVia = qMax(maxVia, in.weight + m_neighbors[j].weight);
+            if (maxVia < 0)
+                break;
+
+            witnessSearch(in.target, v, maxVia, limit);
+            for (int j = i + 1; j < m_neighbors.size(); j++)
+            {
+                const DynArc &out = m_neighbors[j];
+                long via = in.weight + out.weight;
+                if (m_dist[out.target] <= via)
+                    continue;
+                shortcuts++;
+                if (!simulate)
+                    m_pending.append(DynArc{ out.target, via, in.target });
+            }
+            clearSearch();
+
+            // 捷径在该邻居的搜索结束后再插入，避免影响同一轮的见证搜索
+            if (!simulate)
+            {
+                for (int k = 0; k < m_pending.size(); k++)
+                    addShortcut(in.target, m_pending[k].target, m_pending[k].weight, v);
+                m_pending.clear();
+            }
+        }
+        return shortcuts;
+    }
+
+    // 边差优先级：新增捷径 - 删除的边 + 已收缩邻居数
+    long priority(int v)
+    {
+        int shortcuts = contract(v, true);
+        return long(shortcuts) - m_neighbors.size() + m_deletedNeighbors[v];
+    }
+
+    // 正式收缩 v，upArcs 返回 v 指向剩余（更高等级）节点的边
+    int finish(int v, QVector<DynArc> &upArcs)
+    {
+        int shortcuts = contract(v, false);
+        collectNeighbors(v);
+        upArcs = m_neighbors;
+        m_contracted[v] = true;
+        for (int i = 0; i < m_neighbors.size(); i++)
+        {
+            // 从邻居的邻接表中删去 v，使高度数节点的邻接表随收缩变短
+            int u = m_neighbors[i].target;
+            m_deletedNeighbors[u]++;
+            QVector<DynArc> &arcs = m_adj[u];
+            for (int k = 0; k < arcs.size(); k++)
+            {
+                if (arcs[k].target == v)
+                {
+                    arcs[k] = arcs.last();
+                    arcs.removeLast();
+                    break;
+                }
+            }
+        }
+        m_adj[v].clear();
+        m_adj[v].squeeze();
+        return shortcuts;
+    }
+
+private:
+    // 收集 v 尚未收缩的邻居
+    void collectNeighbors(int v)
+    {
+        m_neighbors.clear();
+        QVector<DynArc> &arcs = m_adj[v];
+        int kept = 0;
+        for (int i = 0; i < arcs.size(); i++)
+        {
+            if (m_contracted[arcs[i].target])
+                continue;
+            arcs[kept++] = arcs[i];
+            m_neighbors.append(arcs[i]);
+        }
+        arcs.resize(kept);  // 顺便移除指向已收缩节点的边
+    }
+
+    // 从 source 出发、不经过 avoid 的受限 Dijkstra
+    void witnessSearch(int source, int avoid, long maxDist, int scanLimit)
+    {
+        m_heap.reset(m_nodeCount);
+        m_dist[source] = 0;
+        m_touched.append(source);
+        m_heap.push(source, 0);
+
+        int scanned = 0;
+        while (!m_heap.isEmpty())
+        {
+            long d;
+            int u = m_heap.pop(d);
+            if (d > maxDist)
+                break;
+
+            const QVector<DynArc> &arcs = m_adj[u];
+            scanned += arcs.size();
+            if (scanned > scanLimit && u != source)
+                break;
+            for (int i = 0; i < arcs.size(); i++)
+            {
+                int w = arcs[i].target;
+                if (w == avoid || m_contracted[w])
+                    continue;
+                long nd = d + arcs[i].weight;
+                if (nd < m_dist[w])
+                {
+                    if (m_dist[w] == CsrGraph::UNREACHABLE)
+                        m_touched.append(w);
+                    m_dist[w] = nd;
+                    m_heap.push(w, nd);
+                }
+            }
+        }
+    }
+
+    void clearSearch()
+    {
+        for (int i = 0; i < m_touched.size(); i++)
+            m_dist[m_touched[i]] = CsrGraph::UNREACHABLE;
+        m_touched.clear();
+    }
+
+    void addArc(int from, int to, long weight, int middle)
+    {
+        QVector<DynArc> &arcs = m_adj[from];
+        for (int i = 0; i < arcs.size(); i++)
+        {
+            if (arcs[i].target == to)
+            {
+                if (weight < arcs[i].weight)
+                {
+                    arcs[i].weight = weight;
+                    arcs[i].middle = middle;
+                }
+                return;
+            }
+        }
+        arcs.append(DynArc{ to, weight, middle });
+    }
+
+    void addShortcut(int u, int w, long weight, int middle)
+    {
+        addArc(u, w, weight, middle);
+        addArc(w, u, weight, middle);
+    }
+
+    int m_nodeCount;
+    QVector<QVector<DynArc>> m_adj;
+    QVector<bool> m_contracted;
+    QVector<int> m_deletedNeighbors;
+    QVector<DynArc> m_neighbors;
+    QVector<DynArc> m_pending;
+
+    QVector<long> m_dist;
+    QVector<int> m_touched;
+    DaryHeap<4> m_heap;
+};
+
+} // namespace
+
+ContractionHierarchy::ContractionHierarchy()
+    : m_shortcutCount(0)
+{
+}
+
+bool ContractionHierarchy::build(const CsrGraph &graph)
+{
+    clear();
+
+    // 见证搜索和向上查询都依赖非负边权
+    int n = graph.nodeCount();
+    if (n == 0 || graph.minWeight < 0)
+        return false;
+
+    Contractor contractor(graph);
+
+    // 按优先级（边差）建立初始队列
+    DaryHeap<4> queue;
+    queue.reset(n);
+    for (int v = 1; v <= n; v++)
+        queue.push(v, contractor.priority(v));
+
+    m_rank.fill(0, n + 1);
+    QVector<QVector<DynArc>> upArcs(n + 1);
+    int order = 0;
+
+    while (!queue.isEmpty())
+    {
+        long key;
+        int v = queue.pop(key);
+
+        // 惰性更新：优先级变差且不再最小时重新入队
+        long current = contractor.priority(v);
+        if (!queue.isEmpty() && current > queue.topKey())
+        {
+            queue.push(v, current);
+            continue;
+        }
+
+        m_shortcutCount += contractor.finish(v, upArcs[v]);
+        m_rank[v] = ++order;
+    }
+
+    // 向上图：收缩时 v 的剩余邻居都比 v 等级高
+    m_upOffsets.resize(n + 2);
+    m_upOffsets[0] = 0;
+    for (int v = 1; v <= n; v++)
+    {
+        QVector<DynArc> &arcs = upArcs[v];
+        std::sort(arcs.begin(), arcs.end(), [](const DynArc &a, const DynArc &b) {
+            return a.target < b.target;
+        });
+        m_upOffsets[v] = m_upTargets.size();
+        for (int i = 0; i < arcs.size(); i++)
+        {
+            m_upTargets.append(arcs[i].target);
+            m_upWeights.append(arcs[i].weight);
+            m_upMiddles.append(arcs[i].middle);
+        }
+    }
+    m_upOffsets[n + 1] = m_upTargets.size();
+
+    for (int d = 0; d < 2; d++)
+    {
+        m_distance[d].fill(CsrGraph::UNREACHABLE, n + 1);
+        m_parent[d].fill(0, n + 1);
+        m_heap[d].reset(n);
+    }
+    return true;
+}
+
+void ContractionHierarchy::clear()
+{
+    m_rank.clear();
+    m_upOffsets.clear();
+    m_upTargets.clear();
+    m_upWeights.clear();
+    m_upMiddles.clear();
+    m_shortcutCount = 0;
+    for (int d = 0; d < 2; d++)
+    {
+        m_distance[d].clear();
+        m_parent[d].clear();
+        m_touched[d].clear();
+    }
+}
+
+qint64 ContractionHierarchy::memoryUsage() const
+{
+    qint64 bytes = qint64(m_rank.capacity()) * sizeof(int)
+                 + qint64(m_upOffsets.capacity()) * sizeof(int)
+                 + qint64(m_upTargets.capacity()) * sizeof(int)
+                 + qint64(m_upWeights.capacity()) * sizeof(long)
+                 + qint64(m_upMiddles.capacity()) * sizeof(int);
+    for (int d = 0; d < 2; d++)
+        bytes += qint64(m_distance[d].capacity()) * sizeof(long) + qint64(m_parent[d].capacity()) * sizeof(int);
+    return bytes;
+}
+
+long ContractionHierarchy::query(int source, int target, QVector<int> *path, int *settled)
+{
+    int n = nodeCount();
+    for (int d = 0; d < 2; d++)
+    {
+        for (int i = 0; i < m_touched[d].size(); i++)
+        {
+            m_distance[d][m_touched[d][i]] = CsrGraph::UNREACHABLE;
+            m_parent[d][m_touched[d][i]] = 0;
+        }
+        m_touched[d].clear();
+        m_heap[d].reset(n);
+    }
+
+    const int roots[2] = { source, target };
+    for (int d = 0; d < 2; d++)
+    {
+        m_distance[d][roots[d]] = 0;
+        m_touched[d].append(roots[d]);
+        m_heap[d].push(roots[d], 0);
+    }
+
+    const int *offsets = m_upOffsets.constData();
+    const int *targets = m_upTargets.constData();
+    const long *weights = m_upWeights.constData();
+
+    long best = CsrGraph::UNREACHABLE;
+    int meet = 0;
+    int settledCount = 0;
+    bool done[2] = { false, false };
+    int d = 0;
+
+    // 两侧都在向上图中搜索，某侧队首不小于当前最优值时该侧结束
+    while (!done[0] || !done[1])
+    {
+        if (done[d])
+            d = 1 - d;
+        if (m_heap[d].isEmpty() || m_heap[d].topKey() >= best)
+        {
+            done[d] = true;
+            continue;
+        }
+
+        long du;
+        int u = m_heap[d].pop(du);
+        settledCount++;
+
+        long other = m_distance[1 - d][u];
+        if (other < CsrGraph::UNREACHABLE && du + other < best)
+        {
+            best = du + other;
+            meet = u;
+        }
+
+        for (int e = offsets[u]; e < offsets[u + 1]; e++)
+        {
+            int v = targets[e];
+            long nd = du + weights[e];
+            if (nd < m_distance[d][v])
+            {
+                if (m_distance[d][v] == CsrGraph::UNREACHABLE)
+                    m_touched[d].append(v);
+                m_distance[d][v] = nd;
+                m_parent[d][v] = u;
+                m_heap[d].push(v, nd);
+            }
+        }
+
+        if (!done[1 - d])
+            d = 1 - d;
+    }
+
+    if (settled)
+        *settled = settledCount;
+
+    if (best >= CsrGraph::UNREACHABLE || !path)
+        return best;
+
+    // 向上图中的路径：起点 -> 交汇点 <- 终点
+    QVector<int> coarse;
+    for (int node = meet; node != source; node = m_parent[0][node])
+        coarse.append(node);
+    coarse.append(source);
+    std::reverse(coarse.begin(), coarse.end());
+    for (int node = meet; node != target; )
+    {
+        node = m_parent[1][node];
+        coarse.append(node);
+    }
+
+    // 展开捷径
+    path->clear();
+    path->append(source);
+    for (int i = 1; i < coarse.size(); i++)
+        unpackEdge(coarse[i - 1], coarse[i], *path);
+    return best;
+}
+
+int ContractionHierarchy::findUpArc(int from, int to) const
+{
+    const int *first = m_upTargets.constData() + m_upOffsets[from];
+    const int *last = m_upTargets.constData() + m_upOffsets[from + 1];
+    const int *it = std::lower_bound(first, last, to);
+    return (it != last && *it == to) ? int(it - m_upTargets.constData()) : -1;
+}
+
+void ContractionHierarchy::unpackEdge(int from, int to, QVector<int> &path) const
+{
+    // 显式栈，避免长捷径链导致递归过深；依次追加 from 之后直到 to 的节点
+    QVector<QPair<int, int>> stack;
+    stack.append(qMakePair(from, to));
+    while (!stack.isEmpty())
+    {
+        QPair<int, int> edge = stack.takeLast();
+        int a = edge.first;
+        int b = edge.second;
+        int low = m_rank[a] < m_rank[b] ? a : b;
+        int high = (low == a) ? b : a;
+        int middle = m_upMiddles[findUpArc(low, high)];
+        if (middle == 0)
+        {
+            path.append(b);
+        }
+        else
+        {
+            stack.append(qMakePair(middle, b));
+            stack.append(qMakePair(a, middle));
+        }
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef DIJKSTRA_CH_H
+#define DIJKSTRA_CH_H
+
+#include "dijkstra_csr.h"
+#include "dijkstra_heap.h"
+#include <QVector>
+#include <QtGlobal>
+
+// 收缩层次（Contraction Hierarchies）
+// 预处理：按边差（edge difference）逐个收缩节点，收缩节点 v 时
+// 对每对邻居 u、w 做见证搜索，若不存在不经过 v 且不长于 u-v-w 的路径，则插入捷径 u-w
+// 查询：在只保留“低等级 -> 高等级”边的向上图上做双向搜索，
+// 再把捷径递归展开为原图节点序列
+class ContractionHierarchy
+{
+public:
+    ContractionHierarchy();
+
+    // 在给定图上完成节点排序与收缩；存在负边权时返回 false
+    bool build(const CsrGraph &graph);
+
+    void clear();
+    bool isEmpty() const { return m_rank.isEmpty(); }
+
+    int nodeCount() const { return m_rank.isEmpty() ? 0 : int(m_rank.size()) - 1; }
+    int shortcutCount() const { return m_shortcutCount; }
+    int rank(int node) const { return m_rank[node]; }
+
+    // source 到 target 的最短距离，不可达返回 CsrGraph::UNREACHABLE
+    // path 非空时写入起点到终点的原图节点索引，settled 非空时返回确定的节点数
+    long query(int source, int target, QVector<int> *path = nullptr, int *settled = nullptr);
+
+    // 占用内存（字节）
+    qint64 memoryUsage() const;
+
+private:
+    int findUpArc(int from, int to) const;
+    void unpackEdge(int from, int to, QVector<int> &path) const;
+
+    QVector<int> m_rank;            // 收缩顺序，等级越高越晚收缩
+    QVector<int> m_upOffsets;       // 向上图（CSR），每个节点的边按目标索引升序
+    QVector<int> m_upTargets;
+    QVector<long> m_upWeights;
+    QVector<int> m_upMiddles;       // 捷径经过的被收缩节点，原始边为 0
+    int m_shortcutCount;
+
+    // 查询工作区（0：正向，1：反向），只复位被访问过的节点
+    QVector<long> m_distance[2];
+    QVector<int> m_parent[2];
+    QVector<int> m_touched[2];
+    DaryHeap<4> m_heap[2];
+};
+
+#endif // DIJKSTRA_CH_H
@@ -0,0 +1,65 @@
+#include "dijkstra_csr.h"
+#include "dijkstra_heap.h"
+
+void CsrGraph::shortestPaths(int source, QVector<long> &distance,
+                             QVector<int> *parent, QVector<int> *order) const
+{
+    int n = nodeCount();
+    distance.fill(UNREACHABLE, n + 1);
+    if (parent)
+        parent->fill(0, n + 1);
+    if (order)
+        order->clear();
+
+    const int *offs = offsets.constData();
+    const int *tgts = targets.constData();
+    const long *wts = weights.constData();
+    long *dist = distance.data();
+
+    DaryHeap<4> heap;
+    heap.reset(n);
+    dist[source] = 0;
+    heap.push(source, 0);
+
+    while (!heap.isEmpty())
+    {
+        long d;
+        int u = heap.pop(d);
+        if (order)
+            order->append(u);
+
+        for (int e = offs[u]; e < offs[u + 1]; e++)
+        {
+            int v = tgts[e];
+            long nd = d + wts[e];
+            if (nd < dist[v])
+            {
+                dist[v] = nd;
+                if (parent)
+                    (*parent)[v] = u;
+                heap.push(v, nd);
+            }
+        }
+    }
+}
+
+quint64 CsrGraph::fingerprint() const
+{
+    quint64 hash = 14695981039346656037ULL;
+    auto mix = [&hash](const void *data, qint64 size) {
+        const uchar *bytes = static_cast<const uchar *>(data);
+        for (qint64 i = 0; i < size; i++)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+    };
+    mix(offsets.constData(), qint64(offsets.size()) * sizeof(int));
+    mix(targets.constData(), qint64(targets.size()) * sizeof(int));
+    for (int e = 0; e < weights.size(); e++)
+    {
+        qint64 weight = weights[e];
+        mix(&weight, sizeof(weight));
+    }
+    return hash;
+}
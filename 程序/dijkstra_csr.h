@@ -0,0 +1,76 @@
+#ifndef DIJKSTRA_CSR_H
+#define DIJKSTRA_CSR_H
+
+#include <QVector>
+#include <algorithm>
+
+// 压缩稀疏行（CSR）邻接存储
+// 节点索引与 Dijkstra 内部一致（1..n，0 不使用）
+// 节点 u 的邻接边位于 [offsets[u], offsets[u + 1]) 区间内，
+// targets/weights 为连续数组，同一节点的边按目标索引升序排列
+struct CsrGraph
+{
+    static constexpr long UNREACHABLE = 999999999;  // 不可达距离（即 Dijkstra::MAX_DISTANCE）
+
+    QVector<int> offsets;   // 大小为 n + 2
+    QVector<int> targets;   // 邻接节点索引
+    QVector<long> weights;  // 边权（距离）
+
+    // 边权统计（冻结时计算，用于选择优先队列）；无边时均为 0
+    long minWeight = 0;
+    long maxWeight = 0;
+
+    void clear()
+    {
+        offsets.clear();
+        targets.clear();
+        weights.clear();
+        minWeight = 0;
+        maxWeight = 0;
+    }
+
+    bool isEmpty() const { return offsets.isEmpty(); }
+
+    // 节点数量
+    int nodeCount() const { return offsets.isEmpty() ? 0 : int(offsets.size()) - 2; }
+
+    // 全部边权相同且为正（如单位权图）时返回该边权，否则返回 0；此时最短距离为 BFS 层数乘以该边权
+    // 载入时冻结即可判定；setEdgeDistance 只扩大统计范围，不会误判
+    long uniformWeight() const
+    {
+        return !targets.isEmpty() && minWeight == maxWeight && minWeight > 0 ? minWeight : 0;
+    }
+
+    // 有向边数量（无向边计两次）
+    int arcCount() const { return int(targets.size()); }
+
+    int degree(int node) const { return offsets[node + 1] - offsets[node]; }
+
+    // 查找 from->to 的边，返回其在 targets/weights 中的位置，不存在返回 -1
+    int findArc(int from, int to) const
+    {
+        const int *first = targets.constData() + offsets[from];
+        const int *last = targets.constData() + offsets[from + 1];
+        const int *it = std::lower_bound(first, last, to);
+        return (it != last && *it == to) ? int(it - targets.constData()) : -1;
+    }
+
+    // 单源最短路：distance 调整为 n + 1 大小，不可达节点为 UNREACHABLE
+    // parent 非空时记录最短路径树（起点及不可达节点为 0），
+    // order 非空时按确定（出队）顺序记录可达节点
+    void shortestPaths(int source, QVector<long> &distance,
+                       QVector<int> *parent = nullptr, QVector<int> *order = nullptr) const;
+
+    // 图结构与边权的指纹（FNV-1a），用于校验预处理缓存文件
+    quint64 fingerprint() const;
+
+    // 占用内存（字节）
+    qint64 memoryUsage() const
+    {
+        return qint64(offsets.capacity()) * sizeof(int)
+             + qint64(targets.capacity()) * sizeof(int)
+             + qint64(weights.capacity()) * sizeof(long);
+    }
+};
+
+#endif // DIJKSTRA_CSR_H
@@ -0,0 +1,235 @@
+#include "dijkstra_delta.h"
+#include <QThread>
+#include <QtConcurrent>
+
+namespace {
+
+// 每轮待松弛的节点少于该值时不分发到线程池，避免调度开销超过松弛本身
+const int PARALLEL_MIN_ITEMS = 256;
+
+// 按线程切分 items 并行执行 relax(worker, begin, end)
+template <typename Relax>
+void parallelChunks(const QVector<int> &items, QVector<int> &workers, Relax relax)
+{
+    int count = items.size();
+    int threads = workers.size();
+    if (threads == 1 || count < PARALLEL_MIN_ITEMS)
+    {
+        relax(0, 0, count);
+        return;
+    }
+    QtConcurrent::blockingMap(workers, [&relax, count, threads](int worker) {
+        relax(worker, int(qint64(count) * worker / threads), int(qint64(count) * (worker + 1) / threads));
+    });
+}
+
+} // namespace
+
+DeltaStepping::DeltaStepping()
+    : m_source(0)
+    , m_delta(0)
+    , m_bucketCount(0)
+    , m_phaseCount(0)
+{
+}
+
+long DeltaStepping::chooseDelta(const CsrGraph &graph)
+{
+    // 随机边权下取 delta ≈ 最大边权 / 平均度数，使每个节点平均只有常数条重边被重复松弛
+    int n = graph.nodeCount();
+    if (n == 0 || graph.arcCount() == 0)
+        return 1;
+    double averageDegree = double(graph.arcCount()) / n;
+    return qMax(1L, long(graph.maxWeight / qMax(1.0, averageDegree)));
+}
+
+bool DeltaStepping::run(const CsrGraph &graph, int source, int threadCount, long delta)
+{
+    clear();
+
+    int n = graph.nodeCount();
+    if (n == 0 || source < 1 || source > n || graph.minWeight < 0)
+        return false;
+    if (threadCount <= 0)
+        threadCount = QThread::idealThreadCount();
+    if (delta <= 0)
+        delta = chooseDelta(graph);
+
+    m_source = source;
+    m_delta = delta;
+
+    const int *offsets = graph.offsets.constData();
+    const int *targets = graph.targets.constData();
+    const long *weights = graph.weights.constData();
+
+    QVector<QAtomicInteger<qint64>> tentativeStorage(n + 1, qint64(CsrGraph::UNREACHABLE));
+    QAtomicInteger<qint64> *tentative = tentativeStorage.data();
+
+    // 新距离至多比当前桶的下界大 maxWeight，循环使用 maxWeight / delta + 2 个桶即可
+    int slotCount = int(graph.maxWeight / delta) + 2;
+    QVector<QVector<int>> buckets(slotCount);
+    qint64 pending = 0;
+
+    QVector<int> workers;
+    for (int w = 0; w < threadCount; w++)
+        workers.append(w);
+    QVector<QVector<int>> updatedStorage(threadCount);  // 各线程本轮降低过距离的节点
+    QVector<int> *updated = updatedStorage.data();
+
+    // 松弛 nodes[begin, end) 的轻边或重边，距离用 CAS 取最小值
+    auto relax = [&](const QVector<int> &nodes, bool light, int worker, int begin, int end) {
+        QVector<int> &out = updated[worker];
+        for (int i = begin; i < end; i++)
+        {
+            int u = nodes[i];
+            qint64 du = tentative[u].loadRelaxed();
+            for (int e = offsets[u]; e < offsets[u + 1]; e++)
+            {
+                if ((weights[e] <= delta) != light)
+                    continue;
+                int v = targets[e];
+                qint64 nd = du + weights[e];
+                qint64 current = tentative[v].loadRelaxed();
+                while (nd < current)
+                {
+                    if (tentative[v].testAndSetRelaxed(current, nd))
+                    {
+                        out.append(v);
+                        break;
+                    }
+                    current = tentative[v].loadRelaxed();
+                }
+            }
+        }
+    };
+
+    // 本轮更新过的节点按最终距离入桶（同一节点可能重复，出桶时去重）
+    auto collect = [&]() {
+        for (int w = 0; w < threadCount; w++)
+        {
+            for (int i = 0; i < updated[w].size(); i++)
+            {
+                int v = updated[w][i];
+                buckets[int((tentative[v].loadRelaxed() / delta) % slotCount)].append(v);
+            }
+            pending += updated[w].size();
+            updated[w].clear();
+        }
+    };
+
+    QVector<int> frontierStamp(n + 1, 0), settledStamp(n + 1, 0);
+    int frontierRound = 0;
+    QVector<int> frontier, settled, taken;
+
+    tentative[source].storeRelaxed(0);
+    buckets[0].append(source);
+    pending = 1;
+
+    for (qint64 current = 0; pending > 0; current++)
+    {
+        QVector<int> &bucket = buckets[int(current % slotCount)];
+        if (bucket.isEmpty())
+            continue;
+
+        m_bucketCount++;
+        settled.clear();
+        while (!bucket.isEmpty())
+        {
+            // 取出桶内节点，跳过已移到更小距离桶中的过期条目和重复条目
+            taken.clear();
+            taken.swap(bucket);
+            pending -= taken.size();
+            frontierRound++;
+            frontier.clear();
+            for (int i = 0; i < taken.size(); i++)
+            {
+                int v = taken[i];
+                if (tentative[v].loadRelaxed() / delta != current || frontierStamp[v] == frontierRound)
+                    continue;
+                frontierStamp[v] = frontierRound;
+                frontier.append(v);
+                if (settledStamp[v] != m_bucketCount)
+                {
+                    settledStamp[v] = m_bucketCount;
+                    settled.append(v);
+                }
+            }
+
+            // 轻边可能把节点放回当前桶，继续处理直到当前桶为空
+            parallelChunks(frontier, workers, [&](int worker, int begin, int end) {
+                relax(frontier, true, worker, begin, end);
+            });
+            collect();
+            m_phaseCount++;
+        }
+
+        // 当前桶内节点距离已确定，重边只会更新后面的桶
+        parallelChunks(settled, workers, [&](int worker, int begin, int end) {
+            relax(settled, false, worker, begin, end);
+        });
+        collect();
+        m_phaseCount++;
+    }
+
+    m_distance.resize(n + 1);
+    for (int v = 0; v <= n; v++)
+        m_distance[v] = long(tentative[v].loadRelaxed());
+
+    if (graph.minWeight == 0)
+        computeDepth(graph);
+    return true;
+}
+
+void DeltaStepping::computeDepth(const CsrGraph &graph)
+{
+    // 沿最短路径边（d(u) + w = d(v)）从起点 BFS；零权边可能在等距节点之间成环，
+    // 只允许从层数小的一端指向层数大的一端
+    int n = graph.nodeCount();
+    m_depth.fill(-1, n + 1);
+    QVector<int> queue;
+    queue.append(m_source);
+    m_depth[m_source] = 0;
+    for (int head = 0; head < queue.size(); head++)
+    {
+        int u = queue[head];
+        for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++)
+        {
+            int v = graph.targets[e];
+            if (m_depth[v] < 0 && m_distance[u] + graph.weights[e] == m_distance[v])
+            {
+                m_depth[v] = m_depth[u] + 1;
+                queue.append(v);
+            }
+        }
+    }
+}
+
+void DeltaStepping::parents(const CsrGraph &graph, int node, QList<int> &result) const
+{
+    result.clear();
+    long d = m_distance[node];
+    if (node == m_source || d >= CsrGraph::UNREACHABLE)
+        return;
+
+    // 无向图中 node 的邻接边即指向 node 的边
+    for (int e = graph.offsets[node]; e < graph.offsets[node + 1]; e++)
+    {
+        int u = graph.targets[e];
+        long w = graph.weights[e];
+        if (m_distance[u] >= CsrGraph::UNREACHABLE || m_distance[u] + w != d)
+            continue;
+        if (w == 0 && m_depth[u] >= m_depth[node])
+            continue;
+        result.append(u);
+    }
+}
+
+void DeltaStepping::clear()
+{
+    m_distance.clear();
+    m_depth.clear();
+    m_source = 0;
+    m_delta = 0;
+    m_bucketCount = 0;
+    m_phaseCount = 0;
+}
@@ -0,0 +1,53 @@
+#ifndef DIJKSTRA_DELTA_H
+#define DIJKSTRA_DELTA_H
+
+#include "dijkstra_csr.h"
+#include <QAtomicInteger>
+#include <QList>
+#include <QVector>
+#include <QtGlobal>
+
+// Delta-stepping 并行单源最短路
+// 按距离把节点放入宽度为 delta 的桶，依次处理桶：
+// 桶内节点反复松弛轻边（边权 <= delta），直到桶不再有新节点，再统一松弛这些节点的重边
+// 每轮松弛按线程切分节点，距离用原子 CAS 取最小值，更新过的节点由各线程记录后统一入桶
+// delta 越小越接近 Dijkstra（轮数多、无效松弛少），越大越接近 Bellman-Ford（轮数少、可并行的工作多）
+class DeltaStepping
+{
+public:
+    DeltaStepping();
+
+    // 按边权分布选择 delta：最大边权除以平均度数（至少为 1）
+    static long chooseDelta(const CsrGraph &graph);
+
+    // 从 source 出发计算到所有节点的距离；threadCount <= 0 时使用 QThread::idealThreadCount()，
+    // delta <= 0 时自动选择；存在负边权时返回 false
+    bool run(const CsrGraph &graph, int source, int threadCount = 0, long delta = 0);
+
+    void clear();
+
+    int source() const { return m_source; }
+    long delta() const { return m_delta; }
+    int bucketCount() const { return m_bucketCount; }     // 处理过的非空桶数
+    int phaseCount() const { return m_phaseCount; }       // 并行松弛轮数
+
+    // 节点距离，不可达为 CsrGraph::UNREACHABLE
+    const QVector<long> &distances() const { return m_distance; }
+    long distance(int node) const { return m_distance[node]; }
+
+    // node 在最短路径上的全部前驱（与 Dijkstra 的 parents 含义相同），按 CSR 顺序写入 result
+    // 零权边只取 BFS 层数更小的一端，保证前驱关系无环；只读，可被多个线程同时调用
+    void parents(const CsrGraph &graph, int node, QList<int> &result) const;
+
+private:
+    void computeDepth(const CsrGraph &graph);
+
+    QVector<long> m_distance;
+    QVector<int> m_depth;           // 最短路径 DAG 上的 BFS 层数，仅图中有零权边时计算
+    int m_source;
+    long m_delta;
+    int m_bucketCount;
+    int m_phaseCount;
+};
+
+#endif // DIJKSTRA_DELTA_H
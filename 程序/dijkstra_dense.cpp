@@ -0,0 +1,305 @@
+#include "dijkstra_dense.h"
+#include <QtAlgorithms>
+#include <climits>
+
+namespace {
+
+// 行宽对齐到 AVX2 一次处理的元素个数
+const int LANES = 8;
+const int ALIGNMENT = 32;
+
+// 返回 max(distance[j], visited[j]) 最小的 j 及其值 best；count 为 LANES 的倍数
+typedef int (*MinIndex)(const qint32 *distance, const qint32 *visited, int count, qint32 &best);
+// nd = du + weight[j]，max(nd, visited[j]) < distance[j] 时更新距离与前驱
+typedef void (*RelaxRow)(qint32 *distance, qint32 *parent, const qint32 *weight, const qint32 *visited,
+                         qint32 du, qint32 u, int count, QVector<int> *improved);
+
+int minIndexScalar(const qint32 *distance, const qint32 *visited, int count, qint32 &best)
+{
+    int index = -1;
+    best = INT_MAX;
+    for (int j = 0; j < count; j++)
+    {
+        qint32 key = qMax(distance[j], visited[j]);
+        if (key < best)
+        {
+            best = key;
+            index = j;
+        }
+    }
+    return index;
+}
+
+void relaxRowScalar(qint32 *distance, qint32 *parent, const qint32 *weight, const qint32 *visited,
+                    qint32 du, qint32 u, int count, QVector<int> *improved)
+{
+    for (int j = 0; j < count; j++)
+    {
+        qint32 nd = qMax(du + weight[j], visited[j]);
+        if (nd < distance[j])
+        {
+            distance[j] = nd;
+            parent[j] = u;
+            if (improved)
+                improved->append(j + 1);
+        }
+    }
+}
+
+#ifdef DIJKSTRA_SIMD_X86
+// SSE2 没有 32 位整数的 min/max 和 blend，用比较加与/非与/或选择
+inline __m128i select128(__m128i mask, __m128i a, __m128i b)
+{
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+inline __m128i min128(__m128i a, __m128i b)
+{
+    return select128(_mm_cmpgt_epi32(a, b), b, a);
+}
+
+inline __m128i max128(__m128i a, __m128i b)
+{
+    return select128(_mm_cmpgt_epi32(a, b), a, b);
+}
+
+int minIndexSse2(const qint32 *distance, const qint32 *visited, int count, qint32 &best)
+{
+    __m128i low = _mm_set1_epi32(INT_MAX);
+    for (int j = 0; j < count; j += 4)
+    {
+        __m128i key = max128(_mm_load_si128(reinterpret_cast<const __m128i *>(distance + j)),
+                             _mm_load_si128(reinterpret_cast<const __m128i *>(visited + j)));
+        low = min128(low, key);
+    }
+    low = min128(low, _mm_shuffle_epi32(low, _MM_SHUFFLE(1, 0, 3, 2)));
+    low = min128(low, _mm_shuffle_epi32(low, _MM_SHUFFLE(2, 3, 0, 1)));
+    best = _mm_cvtsi128_si32(low);
+
+    // 第二遍找到第一个等于最小值的位置
+    for (int j = 0; j < count; j += 4)
+    {
+        __m128i key = max128(_mm_load_si128(reinterpret_cast<const __m128i *>(distance + j)),
+                             _mm_load_si128(reinterpret_cast<const __m128i *>(visited + j)));
+        int hits = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(key, low)));
+        if (hits)
+            return j + qCountTrailingZeroBits(quint32(hits));
+    }
+    return -1;
+}
+
+void relaxRowSse2(qint32 *distance, qint32 *parent, const qint32 *weight, const qint32 *visited,
+                  qint32 du, qint32 u, int count, QVector<int> *improved)
+{
+    __m128i viaU = _mm_set1_epi32(du);
+    __m128i from = _mm_set1_epi32(u);
+    for (int j = 0; j < count; j += 4)
+    {
+        __m128i d = _mm_load_si128(reinterpret_cast<const __m128i *>(distance + j));
+        __m128i nd = max128(_mm_add_epi32(viaU, _mm_load_si128(reinterpret_cast<const __m128i *>(weight + j))),
+                            _mm_load_si128(reinterpret_cast<const __m128i *>(visited + j)));
+        __m128i shorter = _mm_cmpgt_epi32(d, nd);
+        int hits = _mm_movemask_ps(_mm_castsi128_ps(shorter));
+        if (!hits)
+            continue;
+        __m128i p = _mm_load_si128(reinterpret_cast<const __m128i *>(parent + j));
+        _mm_store_si128(reinterpret_cast<__m128i *>(distance + j), select128(shorter, nd, d));
+        _mm_store_si128(reinterpret_cast<__m128i *>(parent + j), select128(shorter, from, p));
+        for (; improved && hits; hits &= hits - 1)
+            improved->append(j + qCountTrailingZeroBits(quint32(hits)) + 1);
+    }
+}
+
+DIJKSTRA_TARGET_AVX2
+int minIndexAvx2(const qint32 *distance, const qint32 *visited, int count, qint32 &best)
+{
+    __m256i low = _mm256_set1_epi32(INT_MAX);
+    for (int j = 0; j < count; j += 8)
+    {
+        __m256i key = _mm256_max_epi32(_mm256_load_si256(reinterpret_cast<const __m256i *>(distance + j)),
+                                       _mm256_load_si256(reinterpret_cast<const __m256i *>(visited + j)));
+        low = _mm256_min_epi32(low, key);
+    }
+    __m128i half = _mm_min_epi32(_mm256_castsi256_si128(low), _mm256_extracti128_si256(low, 1));
+    half = _mm_min_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+    half = _mm_min_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+    best = _mm_cvtsi128_si32(half);
+
+    __m256i target = _mm256_set1_epi32(best);
+    for (int j = 0; j < count; j += 8)
+    {
+        __m256i key = _mm256_max_epi32(_mm256_load_si256(reinterpret_cast<const __m256i *>(distance + j)),
+                                       _mm256_load_si256(reinterpret_cast<const __m256i *>(visited + j)));
+        int hits = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(key, target)));
+        if (hits)
+            return j + qCountTrailingZeroBits(quint32(hits));
+    }
+    return -1;
+}
+
+DIJKSTRA_TARGET_AVX2
+void relaxRowAvx2(qint32 *distance, qint32 *parent, const qint32 *weight, const qint32 *visited,
+                  qint32 du, qint32 u, int count, QVector<int> *improved)
+{
+    __m256i viaU = _mm256_set1_epi32(du);
+    __m256i from = _mm256_set1_epi32(u);
+    for (int j = 0; j < count; j += 8)
+    {
+        __m256i d = _mm256_load_si256(reinterpret_cast<const __m256i *>(distance + j));
+        __m256i nd = _mm256_max_epi32(
+            _mm256_add_epi32(viaU, _mm256_load_si256(reinterpret_cast<const __m256i *>(weight + j))),
+            _mm256_load_si256(reinterpret_cast<const __m256i *>(visited + j)));
+        __m256i shorter = _mm256_cmpgt_epi32(d, nd);
+        int hits = _mm256_movemask_ps(_mm256_castsi256_ps(shorter));
+        if (!hits)
+            continue;
+        __m256i p = _mm256_load_si256(reinterpret_cast<const __m256i *>(parent + j));
+        _mm256_store_si256(reinterpret_cast<__m256i *>(distance + j), _mm256_blendv_epi8(d, nd, shorter));
+        _mm256_store_si256(reinterpret_cast<__m256i *>(parent + j), _mm256_blendv_epi8(p, from, shorter));
+        for (; improved && hits; hits &= hits - 1)
+            improved->append(j + qCountTrailingZeroBits(quint32(hits)) + 1);
+    }
+}
+#endif // DIJKSTRA_SIMD_X86
+
+MinIndex minIndexFor(SimdCpu::Level level)
+{
+#ifdef DIJKSTRA_SIMD_X86
+    if (level == SimdCpu::LevelAvx2)
+        return minIndexAvx2;
+    if (level >= SimdCpu::LevelSse2)
+        return minIndexSse2;
+#else
+    Q_UNUSED(level);
+#endif
+    return minIndexScalar;
+}
+
+RelaxRow relaxRowFor(SimdCpu::Level level)
+{
+#ifdef DIJKSTRA_SIMD_X86
+    if (level == SimdCpu::LevelAvx2)
+        return relaxRowAvx2;
+    if (level >= SimdCpu::LevelSse2)
+        return relaxRowSse2;
+#else
+    Q_UNUSED(level);
+#endif
+    return relaxRowScalar;
+}
+
+} // namespace
+
+DenseDijkstra::DenseDijkstra()
+    : m_weights(nullptr)
+    , m_distance(nullptr)
+    , m_parent(nullptr)
+    , m_visited(nullptr)
+    , m_nodeCount(0)
+    , m_stride(0)
+    , m_level(SimdCpu::LevelScalar)
+{
+}
+
+double DenseDijkstra::density(const CsrGraph &graph)
+{
+    // CSR 中每条无向边存两次
+    qint64 n = graph.nodeCount();
+    return n > 1 ? double(graph.targets.size()) / double(n * (n - 1)) : 0.0;
+}
+
+bool DenseDijkstra::suitable(const CsrGraph &graph, double minDensity)
+{
+    int n = graph.nodeCount();
+    return n > 0 && n <= MAX_NODES && graph.minWeight >= 0
+        && qint64(graph.maxWeight) * qMax(n - 1, 1) < INFINITE_DISTANCE
+        && density(graph) >= minDensity;
+}
+
+qint32 *DenseDijkstra::alignedBlock(QVector<qint32> &storage, qint64 count, qint32 value)
+{
+    const int slack = ALIGNMENT / sizeof(qint32);
+    storage.fill(value, count + slack);
+    quintptr address = reinterpret_cast<quintptr>(storage.data());
+    return reinterpret_cast<qint32 *>((address + ALIGNMENT - 1) & ~quintptr(ALIGNMENT - 1));
+}
+
+bool DenseDijkstra::build(const CsrGraph &graph)
+{
+    clear();
+    if (!suitable(graph, 0.0))
+        return false;
+
+    int n = graph.nodeCount();
+    m_nodeCount = n;
+    m_stride = (n + LANES - 1) / LANES * LANES;
+    m_level = SimdCpu::detect();
+
+    // 补齐的列边权为无穷大，永远不会被松弛
+    m_weights = alignedBlock(m_weightStorage, qint64(n) * m_stride, INFINITE_DISTANCE);
+    for (int u = 1; u <= n; u++)
+    {
+        qint32 *row = m_weights + qint64(u - 1) * m_stride;
+        for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++)
+        {
+            int v = graph.targets[e];
+            row[v - 1] = qMin(row[v - 1], qint32(graph.weights[e]));
+        }
+    }
+
+    // 距离、前驱、掩码三行放在同一块内存中，每行都从 32 字节边界开始
+    qint32 *rows = alignedBlock(m_rowStorage, qint64(3) * m_stride, 0);
+    m_distance = rows;
+    m_parent = rows + m_stride;
+    m_visited = rows + 2 * m_stride;
+    return true;
+}
+
+void DenseDijkstra::clear()
+{
+    m_weightStorage.clear();
+    m_weightStorage.squeeze();
+    m_rowStorage.clear();
+    m_rowStorage.squeeze();
+    m_weights = nullptr;
+    m_distance = nullptr;
+    m_parent = nullptr;
+    m_visited = nullptr;
+    m_nodeCount = 0;
+    m_stride = 0;
+}
+
+void DenseDijkstra::reset(int source)
+{
+    for (int j = 0; j < m_stride; j++)
+    {
+        m_distance[j] = INFINITE_DISTANCE;
+        m_parent[j] = 0;
+        // 补齐的列视为已访问，不会被选中
+        m_visited[j] = j < m_nodeCount ? 0 : INFINITE_DISTANCE;
+    }
+    m_distance[source - 1] = 0;
+}
+
+int DenseDijkstra::settleNext(long &distance)
+{
+    qint32 best;
+    int index = minIndexFor(m_level)(m_distance, m_visited, m_stride, best);
+    if (index < 0 || best >= INFINITE_DISTANCE)
+        return 0;
+
+    m_visited[index] = INFINITE_DISTANCE;
+    distance = best;
+    return index + 1;
+}
+
+void DenseDijkstra::relax(int node, QVector<int> *improved)
+{
+    relaxRowFor(m_level)(m_distance, m_parent, m_weights + qint64(node - 1) * m_stride, m_visited,
+                         m_distance[node - 1], node, m_stride, improved);
+}
+
+qint64 DenseDijkstra::memoryUsage() const
+{
+    return qint64(m_weightStorage.capacity() + m_rowStorage.capacity()) * sizeof(qint32);
+}
@@ -0,0 +1,67 @@
+#ifndef DIJKSTRA_DENSE_H
+#define DIJKSTRA_DENSE_H
+
+#include "dijkstra_csr.h"
+#include "dijkstra_simd.h"
+#include <QVector>
+#include <QtGlobal>
+
+// 稠密图（边数接近 V²/2）的 O(V²) 数组 Dijkstra
+// 邻接表展开为 V × stride 的 32 位边权矩阵（无边为“无穷大”），暂定距离、前驱和已访问掩码各为一行，
+// 行宽补齐到 8 个元素并按 32 字节对齐；每轮用 SIMD 在 max(距离, 掩码) 上做水平最小值归约选出下一个节点，
+// 再对它的整行边权做一次向量化松弛。已访问掩码对已确定节点为“无穷大”，未确定节点为 0
+// 与 CSR 上的堆相比没有队列维护和间接寻址，图足够稠密时更快
+class DenseDijkstra
+{
+public:
+    // 边权矩阵最多 MAX_NODES² × 4 字节（64 MB）
+    static const int MAX_NODES = 4096;
+
+    DenseDijkstra();
+
+    // 图能否使用矩阵搜索：节点数不超过 MAX_NODES、边权非负、最大可能距离在 32 位内，
+    // 且密度（边数 / 完全图边数）不低于 minDensity
+    static bool suitable(const CsrGraph &graph, double minDensity);
+    static double density(const CsrGraph &graph);
+
+    // 由 CSR 展开边权矩阵；不满足 suitable(graph, 0) 时返回 false
+    bool build(const CsrGraph &graph);
+    void clear();
+    bool isEmpty() const { return m_nodeCount == 0; }
+    SimdCpu::Level level() const { return m_level; }
+
+    // 开始一次从 source 出发的搜索（节点索引 1..n）
+    void reset(int source);
+
+    // 选出并确定距离最小的未访问节点，写出其距离；没有可达的未访问节点时返回 0
+    int settleNext(long &distance);
+
+    // 用 node 的边权行松弛全部未访问节点；improved 非空时追加距离变小的节点
+    void relax(int node, QVector<int> *improved = nullptr);
+
+    long distance(int node) const { return m_distance[node - 1]; }
+    int parent(int node) const { return m_parent[node - 1]; }
+
+    // 占用内存（字节）
+    qint64 memoryUsage() const;
+
+private:
+    static constexpr qint32 INFINITE_DISTANCE = 0x3FFFFFFF;
+
+    // 在 storage 中分配 count 个元素，返回 32 字节对齐的起始位置
+    static qint32 *alignedBlock(QVector<qint32> &storage, qint64 count, qint32 value);
+
+    QVector<qint32> m_weightStorage;
+    QVector<qint32> m_rowStorage;
+    qint32 *m_weights;              // 第 u 行为节点 u+1 到各节点的边权
+    qint32 *m_distance;             // 暂定距离
+    qint32 *m_parent;               // 前驱（节点索引 1..n）
+    qint32 *m_visited;              // 已访问掩码
+    int m_nodeCount;
+    int m_stride;
+    SimdCpu::Level m_level;
+
+    Q_DISABLE_COPY(DenseDijkstra)
+};
+
+#endif // DIJKSTRA_DENSE_H
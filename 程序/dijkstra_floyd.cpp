@@ -0,0 +1,244 @@
+#include "dijkstra_floyd.h"
+#include "dijkstra_simd.h"
+
+namespace {
+
+// 分块边长：一块距离与下一跳共 2 × 64 × 64 × 4 = 32 KB
+const int TILE = 64;
+// 行宽对齐到 AVX2 一次处理的元素个数
+const int LANES = 8;
+
+// dij[j] = min(dij[j], dik + dkj[j])，变小时 nij[j] = nik；count 为 LANES 的倍数
+typedef void (*RelaxRow)(qint32 *dij, qint32 *nij, const qint32 *dkj, qint32 dik, qint32 nik, int count);
+
+void relaxRowScalar(qint32 *dij, qint32 *nij, const qint32 *dkj, qint32 dik, qint32 nik, int count)
+{
+    for (int j = 0; j < count; j++)
+    {
+        qint32 sum = dik + dkj[j];
+        if (sum < dij[j])
+        {
+            dij[j] = sum;
+            nij[j] = nik;
+        }
+    }
+}
+
+#ifdef DIJKSTRA_SIMD_X86
+void relaxRowSse2(qint32 *dij, qint32 *nij, const qint32 *dkj, qint32 dik, qint32 nik, int count)
+{
+    __m128i viaK = _mm_set1_epi32(dik);
+    __m128i hop = _mm_set1_epi32(nik);
+    for (int j = 0; j < count; j += 4)
+    {
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dij + j));
+        __m128i sum = _mm_add_epi32(viaK, _mm_loadu_si128(reinterpret_cast<const __m128i *>(dkj + j)));
+        __m128i shorter = _mm_cmpgt_epi32(d, sum);
+        __m128i n = _mm_loadu_si128(reinterpret_cast<const __m128i *>(nij + j));
+        // SSE2 没有 blend，用与/非与/或选择
+        d = _mm_or_si128(_mm_and_si128(shorter, sum), _mm_andnot_si128(shorter, d));
+        n = _mm_or_si128(_mm_and_si128(shorter, hop), _mm_andnot_si128(shorter, n));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dij + j), d);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(nij + j), n);
+    }
+}
+
+DIJKSTRA_TARGET_AVX2
+void relaxRowAvx2(qint32 *dij, qint32 *nij, const qint32 *dkj, qint32 dik, qint32 nik, int count)
+{
+    __m256i viaK = _mm256_set1_epi32(dik);
+    __m256i hop = _mm256_set1_epi32(nik);
+    for (int j = 0; j < count; j += 8)
+    {
+        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dij + j));
+        __m256i sum = _mm256_add_epi32(viaK, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dkj + j)));
+        __m256i shorter = _mm256_cmpgt_epi32(d, sum);
+        __m256i n = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(nij + j));
+        d = _mm256_blendv_epi8(d, sum, shorter);
+        n = _mm256_blendv_epi8(n, hop, shorter);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dij + j), d);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(nij + j), n);
+    }
+}
+
+#endif // DIJKSTRA_SIMD_X86
+
+RelaxRow relaxRowFor(FloydWarshall::Kernel kernel)
+{
+#ifdef DIJKSTRA_SIMD_X86
+    if (kernel == FloydWarshall::KernelAvx2)
+        return relaxRowAvx2;
+    if (kernel == FloydWarshall::KernelSse2)
+        return relaxRowSse2;
+#else
+    Q_UNUSED(kernel);
+#endif
+    return relaxRowScalar;
+}
+
+} // namespace
+
+FloydWarshall::FloydWarshall()
+    : m_nodeCount(0)
+    , m_stride(0)
+    , m_scale(1)
+    , m_kernel(KernelScalar)
+{
+}
+
+FloydWarshall::Kernel FloydWarshall::detectKernel()
+{
+#ifdef DIJKSTRA_SIMD_X86
+    static const Kernel detected = SimdCpu::hasAvx2() ? KernelAvx2 : (SimdCpu::hasSse2() ? KernelSse2 : KernelScalar);
+    return detected;
+#else
+    return KernelScalar;
+#endif
+}
+
+const char *FloydWarshall::kernelName(Kernel kernel)
+{
+    switch (kernel)
+    {
+    case KernelAvx2:
+        return "AVX2";
+    case KernelSse2:
+        return "SSE2";
+    case KernelScalar:
+        return "标量";
+    case KernelAuto:
+    default:
+        return "自动";
+    }
+}
+
+bool FloydWarshall::build(const CsrGraph &graph, Kernel kernel)
+{
+    clear();
+
+    int n = graph.nodeCount();
+    if (n == 0 || graph.minWeight < 0
+        || qint64(graph.maxWeight) * qMax(n - 1, 1) >= INFINITE_DISTANCE)
+        return false;
+
+    // 不支持的指令集退回到可用的最快实现（AVX2 > SSE2 > 标量）
+    Kernel available = detectKernel();
+    m_kernel = (kernel == KernelAuto || kernel > available) ? available : kernel;
+
+    // 路径至多 n - 1 条边，放大后边数不会进位到距离部分
+    qint64 pathBound = qint64(qMax(n - 1, 1));
+    if (graph.minWeight == 0 && (qint64(graph.maxWeight) * n + 1) * pathBound < INFINITE_DISTANCE)
+        m_scale = n;
+    qint32 hop = m_scale > 1 ? 1 : 0;
+
+    m_nodeCount = n;
+    m_stride = (n + LANES - 1) / LANES * LANES;
+    m_distances.fill(INFINITE_DISTANCE, qint64(n) * m_stride);
+    m_next.fill(-1, qint64(n) * m_stride);
+
+    for (int u = 1; u <= n; u++)
+    {
+        qint64 row = qint64(u - 1) * m_stride;
+        m_distances[row + u - 1] = 0;
+        m_next[row + u - 1] = u - 1;
+        for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++)
+        {
+            int v = graph.targets[e];
+            qint32 weight = qint32(graph.weights[e]) * m_scale + hop;
+            if (v != u && weight < m_distances[row + v - 1])
+            {
+                m_distances[row + v - 1] = weight;
+                m_next[row + v - 1] = v - 1;
+            }
+        }
+    }
+
+    int tiles = (n + TILE - 1) / TILE;
+    for (int k = 0; k < tiles; k++)
+    {
+        // 对角块只依赖自身；第 k 行、第 k 列的块依赖对角块；其余块依赖同行、同列的这两类块
+        updateTile(k, k, k);
+        for (int j = 0; j < tiles; j++)
+        {
+            if (j != k)
+                updateTile(k, j, k);
+        }
+        for (int i = 0; i < tiles; i++)
+        {
+            if (i != k)
+                updateTile(i, k, k);
+        }
+        for (int i = 0; i < tiles; i++)
+        {
+            if (i == k)
+                continue;
+            for (int j = 0; j < tiles; j++)
+            {
+                if (j != k)
+                    updateTile(i, j, k);
+            }
+        }
+    }
+    return true;
+}
+
+void FloydWarshall::updateTile(int rowTile, int columnTile, int kTile)
+{
+    RelaxRow relax = relaxRowFor(m_kernel);
+    int i0 = rowTile * TILE, i1 = qMin(i0 + TILE, m_nodeCount);
+    int j0 = columnTile * TILE, j1 = qMin(j0 + TILE, m_stride);
+    int k0 = kTile * TILE, k1 = qMin(k0 + TILE, m_nodeCount);
+    qint32 *dist = m_distances.data();
+    qint32 *next = m_next.data();
+
+    for (int k = k0; k < k1; k++)
+    {
+        const qint32 *dkj = dist + qint64(k) * m_stride + j0;
+        for (int i = i0; i < i1; i++)
+        {
+            qint64 row = qint64(i) * m_stride;
+            qint32 dik = dist[row + k];
+            if (dik >= INFINITE_DISTANCE)
+                continue;
+            relax(dist + row + j0, next + row + j0, dkj, dik, next[row + k], j1 - j0);
+        }
+    }
+}
+
+void FloydWarshall::clear()
+{
+    m_distances.clear();
+    m_distances.squeeze();
+    m_next.clear();
+    m_next.squeeze();
+    m_nodeCount = 0;
+    m_stride = 0;
+    m_scale = 1;
+}
+
+bool FloydWarshall::path(int source, int target, QVector<int> &result) const
+{
+    result.clear();
+    int t = target - 1;
+    int node = source - 1;
+    if (m_next[qint64(node) * m_stride + t] < 0)
+        return false;
+
+    result.append(source);
+    while (node != t)
+    {
+        node = m_next[qint64(node) * m_stride + t];
+        if (node < 0 || result.size() > m_nodeCount)
+        {
+            result.clear();
+            return false;
+        }
+        result.append(node + 1);
+    }
+    return true;
+}
+
+qint64 FloydWarshall::memoryUsage() const
+{
+    return qint64(m_distances.capacity() + m_next.capacity()) * sizeof(qint32);
+}
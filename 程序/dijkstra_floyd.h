@@ -0,0 +1,68 @@
+#ifndef DIJKSTRA_FLOYD_H
+#define DIJKSTRA_FLOYD_H
+
+#include "dijkstra_csr.h"
+#include <QVector>
+#include <QtGlobal>
+
+// 小图（可视化窗口规模，几百个节点）的全源距离表：分块 Floyd–Warshall
+// 距离与下一跳各存一个 n × stride 的 32 位矩阵（stride 为 8 的倍数），按 TILE × TILE 分块处理，
+// 每轮 k 先算对角块，再算第 k 行、第 k 列的块，最后算其余块，块内数据留在缓存中
+// 最内层的 min-plus 行更新按运行时检测到的指令集选择 AVX2（8 路）、SSE2（4 路）或标量实现
+// 查询时距离 O(1) 查表，路径沿下一跳表逐跳走出
+class FloydWarshall
+{
+public:
+    // 最内层循环的实现
+    enum Kernel {
+        KernelAuto,         // 按 CPU 支持的指令集自动选择
+        KernelScalar,
+        KernelSse2,
+        KernelAvx2
+    };
+
+    FloydWarshall();
+
+    // 计算全部距离和下一跳；最大可能距离超出 32 位或存在负边权时返回 false
+    // 有零权边时零权环会使下一跳表成环，范围允许时把边权放大为 w × n + 1，等距路径中取边数最少的
+    // 指定的指令集不被 CPU 支持时退回可用的实现
+    bool build(const CsrGraph &graph, Kernel kernel = KernelAuto);
+
+    void clear();
+    bool isEmpty() const { return m_nodeCount == 0; }
+
+    int nodeCount() const { return m_nodeCount; }
+    Kernel kernel() const { return m_kernel; }
+
+    // 当前 CPU 可用的最快实现
+    static Kernel detectKernel();
+    static const char *kernelName(Kernel kernel);
+
+    // source 到 target 的距离（节点索引 1..n），不可达为 CsrGraph::UNREACHABLE
+    long distance(int source, int target) const
+    {
+        qint32 d = m_distances[qint64(source - 1) * m_stride + (target - 1)];
+        return d >= INFINITE_DISTANCE ? CsrGraph::UNREACHABLE : long(d / m_scale);
+    }
+
+    // 沿下一跳表写出 source 到 target 的路径（节点索引），不可达或无法走到终点时返回 false
+    bool path(int source, int target, QVector<int> &result) const;
+
+    // 占用内存（字节）
+    qint64 memoryUsage() const;
+
+private:
+    // 两个“无穷大”相加不溢出 32 位
+    static constexpr qint32 INFINITE_DISTANCE = 0x3FFFFFFF;
+
+    void updateTile(int rowTile, int columnTile, int kTile);
+
+    QVector<qint32> m_distances;    // 第 i 行第 j 列为节点 i+1 到 j+1 的距离
+    QVector<qint32> m_next;         // 下一跳（0 起始的节点编号），不可达为 -1
+    int m_nodeCount;
+    int m_stride;
+    qint32 m_scale;                 // 存储的距离为 真实距离 × m_scale + 边数（有零权边时 m_scale = n，否则为 1 且不计边数）
+    Kernel m_kernel;
+};
+
+#endif // DIJKSTRA_FLOYD_H
@@ -0,0 +1,394 @@
+#ifndef DIJKSTRA_HEAP_H
+#define DIJKSTRA_HEAP_H
+
+#include <QVector>
+#include <QList>
+#include <QtAlgorithms>
+#include <algorithm>
+
+// Dijkstra 使用的优先队列
+// 所有队列提供相同的接口：
+//   reset(n)        为 n 个节点（索引 1..n）准备一次新的搜索
+//   isEmpty()       队列是否为空
+//   push(node, key) 插入节点；若节点已在队列中且 key 更小则降低其键值
+//   pop(key)        弹出键值最小的节点，返回节点索引，key 返回其键值
+// 惰性删除堆、桶队列和基数堆允许同一节点出现多次，调用方需跳过已访问（过期）的条目
+// 桶队列和基数堆是单调整数队列：要求插入的键值不小于最近一次弹出的键值（非负边权的 Dijkstra 满足）
+// 先进先出队列只适用于全部边权相同的图
+
+// 线性扫描队列：与原始实现相同，每次弹出都扫描整个列表，O(V) 每次操作
+// 仅保留用于基准测试对比
+class ScanQueue
+{
+public:
+    void reset(int nodeCount)
+    {
+        m_nodes.clear();
+        if (m_keys.size() != nodeCount + 1)
+            m_keys.resize(nodeCount + 1);
+    }
+
+    bool isEmpty() const { return m_nodes.isEmpty(); }
+
+    void push(int node, long key)
+    {
+        m_keys[node] = key;
+        if (!m_nodes.contains(node))
+            m_nodes.append(node);
+    }
+
+    int pop(long &key)
+    {
+        int minPos = 0;
+        for (int i = 1; i < m_nodes.size(); i++)
+        {
+            if (m_keys[m_nodes[i]] < m_keys[m_nodes[minPos]])
+                minPos = i;
+        }
+        int node = m_nodes[minPos];
+        key = m_keys[node];
+        m_nodes.removeAt(minPos);
+        return node;
+    }
+
+private:
+    QList<int> m_nodes;     // 待处理节点
+    QVector<long> m_keys;   // 节点当前键值（按节点索引）
+};
+
+// 带索引的 D 叉堆：支持 O(log_D V) 的降键操作
+// m_pos 记录每个节点在堆中的位置（-1 表示不在堆中），弹出时即复位，
+// 因此一次完整搜索结束后 reset() 无需重新填充整个数组
+template <int D>
+class DaryHeap
+{
+public:
+    void reset(int nodeCount)
+    {
+        if (m_pos.size() != nodeCount + 1)
+        {
+            m_pos.fill(-1, nodeCount + 1);
+            m_keys.resize(nodeCount + 1);
+        }
+        else
+        {
+            // 提前终止的搜索可能在堆中留下节点
+            for (int i = 0; i < m_heap.size(); i++)
+                m_pos[m_heap[i]] = -1;
+        }
+        m_heap.clear();
+    }
+
+    bool isEmpty() const { return m_heap.isEmpty(); }
+    int size() const { return m_heap.size(); }
+    bool contains(int node) const { return m_pos[node] >= 0; }
+    long topKey() const { return m_keys[m_heap[0]]; }
+
+    void push(int node, long key)
+    {
+        int pos = m_pos[node];
+        if (pos < 0)
+        {
+            m_keys[node] = key;
+            m_heap.append(node);
+            siftUp(m_heap.size() - 1);
+        }
+        else if (key < m_keys[node])
+        {
+            m_keys[node] = key;
+            siftUp(pos);
+        }
+    }
+
+    int pop(long &key)
+    {
+        int top = m_heap[0];
+        key = m_keys[top];
+        m_pos[top] = -1;
+
+        int last = m_heap.last();
+        m_heap.removeLast();
+        if (!m_heap.isEmpty())
+        {
+            m_heap[0] = last;
+            m_pos[last] = 0;
+            siftDown(0);
+        }
+        return top;
+    }
+
+private:
+    void siftUp(int pos)
+    {
+        int node = m_heap[pos];
+        long key = m_keys[node];
+        while (pos > 0)
+        {
+            int parent = (pos - 1) / D;
+            int parentNode = m_heap[parent];
+            if (m_keys[parentNode] <= key)
+                break;
+            m_heap[pos] = parentNode;
+            m_pos[parentNode] = pos;
+            pos = parent;
+        }
+        m_heap[pos] = node;
+        m_pos[node] = pos;
+    }
+
+    void siftDown(int pos)
+    {
+        int count = m_heap.size();
+        int node = m_heap[pos];
+        long key = m_keys[node];
+        while (true)
+        {
+            int first = pos * D + 1;
+            if (first >= count)
+                break;
+            int last = std::min(first + D, count);
+            int best = first;
+            for (int c = first + 1; c < last; c++)
+            {
+                if (m_keys[m_heap[c]] < m_keys[m_heap[best]])
+                    best = c;
+            }
+            int bestNode = m_heap[best];
+            if (m_keys[bestNode] >= key)
+                break;
+            m_heap[pos] = bestNode;
+            m_pos[bestNode] = pos;
+            pos = best;
+        }
+        m_heap[pos] = node;
+        m_pos[node] = pos;
+    }
+
+    QVector<int> m_heap;    // 堆数组，存放节点索引
+    QVector<int> m_pos;     // 节点在堆中的位置
+    QVector<long> m_keys;   // 节点键值（按节点索引）
+};
+
+// 惰性删除二叉堆：不做降键，距离变小时直接插入新条目，
+// 弹出时由调用方丢弃已访问节点的过期条目
+class LazyBinaryHeap
+{
+public:
+    void reset(int nodeCount)
+    {
+        Q_UNUSED(nodeCount);
+        m_heap.clear();
+    }
+
+    bool isEmpty() const { return m_heap.isEmpty(); }
+    int size() const { return m_heap.size(); }
+
+    void push(int node, long key)
+    {
+        m_heap.append(Entry{key, node});
+        std::push_heap(m_heap.begin(), m_heap.end(), Entry::greater);
+    }
+
+    int pop(long &key)
+    {
+        std::pop_heap(m_heap.begin(), m_heap.end(), Entry::greater);
+        Entry top = m_heap.last();
+        m_heap.removeLast();
+        key = top.key;
+        return top.node;
+    }
+
+private:
+    struct Entry
+    {
+        long key;
+        int node;
+
+        static bool greater(const Entry &a, const Entry &b) { return a.key > b.key; }
+    };
+
+    QVector<Entry> m_heap;
+};
+
+// Dial 桶队列：边权为不超过 C 的非负整数时，队列中的键值都落在 [当前最小值, 当前最小值 + C] 内，
+// 用 C + 1 个桶循环存放，插入 O(1)，弹出时顺序扫描桶，扫描总代价不超过最大距离
+// 适合最大边权较小的图，setMaxWeight() 需在 reset() 之前设置
+class DialQueue
+{
+public:
+    // 超过该最大边权时桶数过多，宜改用基数堆
+    static const long MAX_WEIGHT = 1024;
+
+    DialQueue() : m_maxWeight(0), m_current(0), m_size(0) {}
+
+    void setMaxWeight(long maxWeight) { m_maxWeight = maxWeight; }
+
+    void reset(int nodeCount)
+    {
+        Q_UNUSED(nodeCount);
+        int bucketCount = int(m_maxWeight) + 1;
+        if (m_buckets.size() != bucketCount)
+        {
+            m_buckets.clear();
+            m_buckets.resize(bucketCount);
+        }
+        else if (m_size > 0)
+        {
+            // 提前终止的搜索可能在桶中留下节点
+            for (int i = 0; i < m_buckets.size(); i++)
+                m_buckets[i].clear();
+        }
+        m_current = 0;
+        m_size = 0;
+    }
+
+    bool isEmpty() const { return m_size == 0; }
+    int size() const { return m_size; }
+
+    void push(int node, long key)
+    {
+        m_buckets[int(key % m_buckets.size())].append(node);
+        m_size++;
+    }
+
+    int pop(long &key)
+    {
+        int bucketCount = m_buckets.size();
+        int index = int(m_current % bucketCount);
+        while (m_buckets[index].isEmpty())
+        {
+            m_current++;
+            if (++index == bucketCount)
+                index = 0;
+        }
+        int node = m_buckets[index].last();
+        m_buckets[index].removeLast();
+        m_size--;
+        key = m_current;
+        return node;
+    }
+
+private:
+    QVector<QVector<int>> m_buckets;    // 键值 k 的节点位于 k % (C + 1) 号桶
+    long m_maxWeight;                   // 最大边权 C
+    long m_current;                     // 当前最小键值
+    int m_size;
+};
+
+// 基数堆：按键值与上次弹出键值 last 的最高不同位分桶（第 i 个桶存放 last ^ key 的位长为 i 的条目）
+// 0 号桶为空时取出第一个非空桶中的最小键值作为新的 last，并把该桶的条目重新分到更低的桶，
+// 每个条目最多下移 64 次，与边权大小无关
+class RadixHeap
+{
+public:
+    RadixHeap() : m_last(0), m_size(0) {}
+
+    void reset(int nodeCount)
+    {
+        Q_UNUSED(nodeCount);
+        if (m_size > 0)
+        {
+            for (int i = 0; i < BUCKET_COUNT; i++)
+                m_buckets[i].clear();
+        }
+        m_last = 0;
+        m_size = 0;
+    }
+
+    bool isEmpty() const { return m_size == 0; }
+    int size() const { return m_size; }
+
+    void push(int node, long key)
+    {
+        m_buckets[bucketIndex(key)].append(Entry{key, node});
+        m_size++;
+    }
+
+    int pop(long &key)
+    {
+        if (m_buckets[0].isEmpty())
+        {
+            int i = 1;
+            while (m_buckets[i].isEmpty())
+                i++;
+
+            QVector<Entry> &bucket = m_buckets[i];
+            long minKey = bucket[0].key;
+            for (int k = 1; k < bucket.size(); k++)
+                minKey = std::min(minKey, bucket[k].key);
+            m_last = minKey;
+
+            // 相对新的 last，这些条目的最高不同位都低于 i
+            for (int k = 0; k < bucket.size(); k++)
+                m_buckets[bucketIndex(bucket[k].key)].append(bucket[k]);
+            bucket.clear();
+        }
+
+        Entry top = m_buckets[0].last();
+        m_buckets[0].removeLast();
+        m_size--;
+        key = top.key;
+        return top.node;
+    }
+
+private:
+    static const int BUCKET_COUNT = 65;
+
+    struct Entry
+    {
+        long key;
+        int node;
+    };
+
+    int bucketIndex(long key) const
+    {
+        quint64 diff = quint64(key) ^ quint64(m_last);
+        return diff == 0 ? 0 : 64 - int(qCountLeadingZeroBits(diff));
+    }
+
+    QVector<Entry> m_buckets[BUCKET_COUNT];
+    long m_last;                        // 最近一次弹出的键值
+    int m_size;
+};
+
+// 先进先出队列（广度优先搜索）：全部边权相同时按插入顺序弹出的键值单调不减，
+// 节点第一次入队时的键值即最终距离，不会产生过期条目，插入与弹出均为 O(1)
+class FifoQueue
+{
+public:
+    FifoQueue() : m_head(0) {}
+
+    void reset(int nodeCount)
+    {
+        m_entries.clear();
+        m_entries.reserve(nodeCount);
+        m_head = 0;
+    }
+
+    bool isEmpty() const { return m_head == m_entries.size(); }
+    int size() const { return int(m_entries.size()) - m_head; }
+
+    void push(int node, long key)
+    {
+        m_entries.append(Entry{key, node});
+    }
+
+    int pop(long &key)
+    {
+        const Entry &front = m_entries[m_head++];
+        key = front.key;
+        return front.node;
+    }
+
+private:
+    struct Entry
+    {
+        long key;
+        int node;
+    };
+
+    QVector<Entry> m_entries;           // 弹出的条目保留到下次 reset，只移动队首位置
+    int m_head;
+};
+
+#endif // DIJKSTRA_HEAP_H
@@ -0,0 +1,370 @@
+#include "dijkstra_hub.h"
+#include "dijkstra_heap.h"
+#include <QFile>
+#include <QThread>
+#include <QtConcurrent>
+#include <algorithm>
+
+namespace {
+
+const quint32 HUB_FILE_MAGIC = 0x4C425548;     // "HUBL"
+const quint32 HUB_FILE_VERSION = 1;
+
+// 前 SEQUENTIAL_ROOTS 个根（度数最高，剪枝效果最好）逐个处理，之后按批并行
+const int SEQUENTIAL_ROOTS = 32;
+const int BATCH_PER_THREAD = 4;
+
+// 标签文件头，其后依次为 m_order、m_offsets、m_hubs、m_distances、m_parents
+struct HubFileHeader
+{
+    quint32 magic;
+    quint32 version;
+    quint64 fingerprint;
+    qint32 nodeCount;
+    qint32 entryCount;
+};
+
+struct LabelEntry
+{
+    int hub;
+    qint32 distance;
+    int parent;
+};
+
+// 一次剪枝搜索确定的节点
+struct Visit
+{
+    int node;
+    qint32 distance;
+    int parent;
+};
+
+// 单个线程的剪枝搜索工作区，只复位被访问过的节点
+struct PrunedSearch
+{
+    QVector<long> distance;
+    QVector<int> parent;
+    QVector<int> touched;
+    QVector<long> rootDistance;     // 根的已有标签，按中心点等级索引
+    DaryHeap<4> heap;
+
+    void init(int nodeCount)
+    {
+        distance.fill(CsrGraph::UNREACHABLE, nodeCount + 1);
+        parent.fill(0, nodeCount + 1);
+        rootDistance.fill(CsrGraph::UNREACHABLE, nodeCount + 1);
+        heap.reset(nodeCount);
+    }
+
+    // 从根 root 出发，found 返回未被剪枝的节点，即需要加入 root 的标签项
+    void run(const CsrGraph &graph, const QVector<QVector<LabelEntry>> &labels,
+             int root, QVector<Visit> &found)
+    {
+        found.clear();
+        const QVector<LabelEntry> &rootLabel = labels[root];
+        for (int i = 0; i < rootLabel.size(); i++)
+            rootDistance[rootLabel[i].hub] = rootLabel[i].distance;
+
+        heap.reset(graph.nodeCount());
+        distance[root] = 0;
+        touched.append(root);
+        heap.push(root, 0);
+
+        while (!heap.isEmpty())
+        {
+            long d;
+            int u = heap.pop(d);
+
+            // 已有标签可以覆盖 root-u 时剪枝
+            const QVector<LabelEntry> &label = labels[u];
+            bool covered = false;
+            for (int i = 0; i < label.size() && !covered; i++)
+            {
+                long viaHub = rootDistance[label[i].hub];
+                covered = viaHub < CsrGraph::UNREACHABLE && viaHub + label[i].distance <= d;
+            }
+            if (covered)
+                continue;
+
+            found.append(Visit{ u, qint32(d), parent[u] });
+
+            for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++)
+            {
+                int v = graph.targets[e];
+                long nd = d + graph.weights[e];
+                if (nd < distance[v])
+                {
+                    if (distance[v] == CsrGraph::UNREACHABLE)
+                        touched.append(v);
+                    distance[v] = nd;
+                    parent[v] = u;
+                    heap.push(v, nd);
+                }
+            }
+        }
+
+        for (int i = 0; i < touched.size(); i++)
+        {
+            distance[touched[i]] = CsrGraph::UNREACHABLE;
+            parent[touched[i]] = 0;
+        }
+        touched.clear();
+        for (int i = 0; i < rootLabel.size(); i++)
+            rootDistance[rootLabel[i].hub] = CsrGraph::UNREACHABLE;
+    }
+};
+
+} // namespace
+
+HubLabels::HubLabels()
+{
+}
+
+bool HubLabels::build(const CsrGraph &graph, int threadCount)
+{
+    clear();
+
+    // 剪枝搜索按 Dijkstra 顺序确定距离，负边权下标签不正确
+    int n = graph.nodeCount();
+    if (n == 0 || graph.minWeight < 0)
+        return false;
+    if (threadCount <= 0)
+        threadCount = QThread::idealThreadCount();
+
+    // 按度数降序确定等级，度数高的节点覆盖的最短路径多，先处理可以剪掉更多搜索
+    m_order.resize(n + 1);
+    m_order[0] = 0;
+    for (int v = 1; v <= n; v++)
+        m_order[v] = v;
+    std::stable_sort(m_order.begin() + 1, m_order.end(), [&graph](int a, int b) {
+        return graph.degree(a) > graph.degree(b);
+    });
+
+    QVector<QVector<LabelEntry>> labels(n + 1);
+    QVector<PrunedSearch> searches(threadCount);
+    for (int i = 0; i < threadCount; i++)
+        searches[i].init(n);
+
+    QVector<QVector<Visit>> found;
+    QVector<int> workers;
+    int next = 1;
+    while (next <= n)
+    {
+        int batch = next <= SEQUENTIAL_ROOTS ? 1 : qMin(threadCount * BATCH_PER_THREAD, n - next + 1);
+        found.resize(batch);
+
+        if (batch == 1)
+        {
+            searches[0].run(graph, labels, m_order[next], found[0]);
+        }
+        else
+        {
+            // 每个线程使用固定的工作区，按步长处理本批中的根；搜索期间标签只读
+            workers.clear();
+            for (int w = 0; w < qMin(threadCount, batch); w++)
+                workers.append(w);
+            int first = next;
+            int stride = workers.size();
+            QtConcurrent::blockingMap(workers, [&, first, batch, stride](int worker) {
+                for (int i = worker; i < batch; i += stride)
+                    searches[worker].run(graph, labels, m_order[first + i], found[i]);
+            });
+        }
+
+        // 按等级顺序写入，保持每个标签内中心点升序
+        for (int i = 0; i < batch; i++)
+        {
+            int hub = next + i;
+            for (int k = 0; k < found[i].size(); k++)
+            {
+                const Visit &visit = found[i][k];
+                labels[visit.node].append(LabelEntry{ hub, visit.distance, visit.parent });
+            }
+        }
+        next += batch;
+    }
+
+    // 压平为连续数组
+    qint64 total = 0;
+    for (int v = 1; v <= n; v++)
+        total += labels[v].size();
+    m_offsets.resize(n + 2);
+    m_hubs.reserve(total);
+    m_distances.reserve(total);
+    m_parents.reserve(total);
+    m_offsets[0] = 0;
+    for (int v = 1; v <= n; v++)
+    {
+        m_offsets[v] = m_hubs.size();
+        const QVector<LabelEntry> &label = labels[v];
+        for (int i = 0; i < label.size(); i++)
+        {
+            m_hubs.append(label[i].hub);
+            m_distances.append(label[i].distance);
+            m_parents.append(label[i].parent);
+        }
+        labels[v].clear();
+        labels[v].squeeze();
+    }
+    m_offsets[n + 1] = m_hubs.size();
+    return true;
+}
+
+void HubLabels::clear()
+{
+    m_order.clear();
+    m_offsets.clear();
+    m_hubs.clear();
+    m_hubs.squeeze();
+    m_distances.clear();
+    m_distances.squeeze();
+    m_parents.clear();
+    m_parents.squeeze();
+}
+
+int HubLabels::maxLabelSize() const
+{
+    int result = 0;
+    for (int v = 1; v <= nodeCount(); v++)
+        result = qMax(result, m_offsets[v + 1] - m_offsets[v]);
+    return result;
+}
+
+qint64 HubLabels::memoryUsage() const
+{
+    return qint64(m_order.capacity() + m_offsets.capacity()) * sizeof(int)
+         + qint64(m_hubs.capacity()) * sizeof(int)
+         + qint64(m_distances.capacity()) * sizeof(qint32)
+         + qint64(m_parents.capacity()) * sizeof(int);
+}
+
+long HubLabels::query(int source, int target, QVector<int> *path) const
+{
+    const int *hubs = m_hubs.constData();
+    const qint32 *distances = m_distances.constData();
+
+    // 归并两个有序标签，取公共中心点上距离之和的最小值
+    long best = CsrGraph::UNREACHABLE;
+    int bestHub = 0;
+    int i = m_offsets[source], iEnd = m_offsets[source + 1];
+    int j = m_offsets[target], jEnd = m_offsets[target + 1];
+    while (i < iEnd && j < jEnd)
+    {
+        if (hubs[i] < hubs[j])
+        {
+            i++;
+        }
+        else if (hubs[i] > hubs[j])
+        {
+            j++;
+        }
+        else
+        {
+            long d = long(distances[i]) + distances[j];
+            if (d < best)
+            {
+                best = d;
+                bestHub = hubs[i];
+            }
+            i++;
+            j++;
+        }
+    }
+
+    if (!path || best >= CsrGraph::UNREACHABLE)
+        return best;
+
+    // 两侧分别沿下一跳走到中心点
+    int hubNode = m_order[bestHub];
+    path->clear();
+    for (int node = source; ; node = m_parents[findEntry(node, bestHub)])
+    {
+        path->append(node);
+        if (node == hubNode)
+            break;
+    }
+    QVector<int> tail;
+    for (int node = target; node != hubNode; node = m_parents[findEntry(node, bestHub)])
+        tail.append(node);
+    for (int k = tail.size() - 1; k >= 0; k--)
+        path->append(tail[k]);
+    return best;
+}
+
+int HubLabels::findEntry(int node, int hub) const
+{
+    const int *first = m_hubs.constData() + m_offsets[node];
+    const int *last = m_hubs.constData() + m_offsets[node + 1];
+    const int *it = std::lower_bound(first, last, hub);
+    return int(it - m_hubs.constData());
+}
+
+bool HubLabels::save(const QString &fileName, const CsrGraph &graph) const
+{
+    if (isEmpty())
+        return false;
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    HubFileHeader header = { HUB_FILE_MAGIC, HUB_FILE_VERSION, graph.fingerprint(),
+                 qint32(nodeCount()), qint32(entryCount()) };
+
+    bool ok = file.write(reinterpret_cast<const char *>(&header), sizeof(header)) == qint64(sizeof(header));
+    auto writeArray = [&file, &ok](const auto &array) {
+        qint64 bytes = qint64(array.size()) * sizeof(array[0]);
+        if (ok)
+            ok = file.write(reinterpret_cast<const char *>(array.constData()), bytes) == bytes;
+    };
+    writeArray(m_order);
+    writeArray(m_offsets);
+    writeArray(m_hubs);
+    writeArray(m_distances);
+    writeArray(m_parents);
+    file.close();
+    return ok;
+}
+
+bool HubLabels::load(const QString &fileName, const CsrGraph &graph)
+{
+    clear();
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    HubFileHeader header;
+
+    if (file.read(reinterpret_cast<char *>(&header), sizeof(header)) != qint64(sizeof(header))
+        || header.magic != HUB_FILE_MAGIC || header.version != HUB_FILE_VERSION
+        || header.nodeCount != graph.nodeCount() || header.fingerprint != graph.fingerprint())
+        return false;
+
+    int n = header.nodeCount;
+    m_order.resize(n + 1);
+    m_offsets.resize(n + 2);
+    m_hubs.resize(header.entryCount);
+    m_distances.resize(header.entryCount);
+    m_parents.resize(header.entryCount);
+
+    bool ok = true;
+    auto readArray = [&file, &ok](auto &array) {
+        qint64 bytes = qint64(array.size()) * sizeof(array[0]);
+        if (ok)
+            ok = file.read(reinterpret_cast<char *>(array.data()), bytes) == bytes;
+    };
+    readArray(m_order);
+    readArray(m_offsets);
+    readArray(m_hubs);
+    readArray(m_distances);
+    readArray(m_parents);
+    file.close();
+
+    if (!ok || m_offsets[n + 1] != header.entryCount)
+    {
+        clear();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,54 @@
+#ifndef DIJKSTRA_HUB_H
+#define DIJKSTRA_HUB_H
+
+#include "dijkstra_csr.h"
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+// 中心点标签（Hub Labeling）距离预言机，使用剪枝地标标签（Pruned Landmark Labeling）构建
+// 按度数从高到低依次从每个节点出发做剪枝 Dijkstra：若已有标签已能给出不大于当前距离的结果则剪枝，
+// 否则把（当前根, 距离）加入被访问节点的标签
+// 查询 d(s, t) 只需归并 s、t 两个按中心点等级排序的标签数组，无需搜索
+// 每个标签项同时记录朝向中心点的下一跳，用于还原路径
+class HubLabels
+{
+public:
+    HubLabels();
+
+    // 构建标签；threadCount <= 0 时使用 QThread::idealThreadCount()，存在负边权时返回 false
+    // 前若干个根逐个处理，之后按批并行，同一批内的根互不剪枝（标签略多但仍正确）
+    bool build(const CsrGraph &graph, int threadCount = 0);
+
+    void clear();
+    bool isEmpty() const { return m_order.isEmpty(); }
+
+    int nodeCount() const { return m_order.isEmpty() ? 0 : int(m_order.size()) - 1; }
+
+    // 标签规模
+    qint64 entryCount() const { return m_hubs.size(); }
+    double averageLabelSize() const { return nodeCount() > 0 ? double(entryCount()) / nodeCount() : 0.0; }
+    int maxLabelSize() const;
+
+    // source 到 target 的最短距离，不可达返回 CsrGraph::UNREACHABLE
+    // path 非空时写入起点到终点的节点索引；只读，可被多个线程同时调用
+    long query(int source, int target, QVector<int> *path = nullptr) const;
+
+    // 序列化到文件（本机字节序，作为缓存使用）；load 时校验图的指纹，图已变化则返回 false
+    bool save(const QString &fileName, const CsrGraph &graph) const;
+    bool load(const QString &fileName, const CsrGraph &graph);
+
+    // 占用内存（字节）
+    qint64 memoryUsage() const;
+
+private:
+    int findEntry(int node, int hub) const;
+
+    QVector<int> m_order;           // 等级 -> 节点（等级从 1 开始，与节点索引同为 1..n）
+    QVector<int> m_offsets;         // 节点 v 的标签位于 [m_offsets[v], m_offsets[v + 1])
+    QVector<int> m_hubs;            // 中心点等级，每个标签内升序
+    QVector<qint32> m_distances;    // 到中心点的距离
+    QVector<int> m_parents;         // 朝向中心点的下一跳节点，中心点自身为 0
+};
+
+#endif // DIJKSTRA_HUB_H
@@ -0,0 +1,157 @@
+#include "dijkstra_idmap.h"
+#include <limits>
+
+NodeIdMap::NodeIdMap()
+    : m_isDirect(true)
+    , m_base(0)
+    , m_size(0)
+    , m_minId(0)
+    , m_maxId(0)
+{
+}
+
+void NodeIdMap::insert(long id, int index)
+{
+    long minId = m_size == 0 ? id : qMin(m_minId, id);
+    long maxId = m_size == 0 ? id : qMax(m_maxId, id);
+    if (m_isDirect && !denseEnough(minId, maxId, m_size + 1))
+        convertToSlots();
+
+    if (m_isDirect)
+        insertDirect(id, index);
+    else
+        insertSlot(id, index);
+    m_minId = minId;
+    m_maxId = maxId;
+    m_size++;
+}
+
+void NodeIdMap::compact()
+{
+    if (m_size == 0 || !denseEnough(m_minId, m_maxId, m_size))
+        return;
+
+    int span = int(quint64(m_maxId) - quint64(m_minId)) + 1;
+    if (m_isDirect)
+    {
+        if (m_direct.size() > span)
+            rebuildDirect(quint64(m_minId), span);
+        return;
+    }
+
+    QVector<int> direct(span, 0);
+    for (int i = 0; i < m_slots.size(); i++)
+    {
+        if (m_slots[i].index != 0)
+            direct[int(quint64(m_slots[i].id) - quint64(m_minId))] = m_slots[i].index;
+    }
+    m_direct.swap(direct);
+    m_base = quint64(m_minId);
+    m_slots.clear();
+    m_slots.squeeze();
+    m_isDirect = true;
+}
+
+void NodeIdMap::clear()
+{
+    m_isDirect = true;
+    m_direct.clear();
+    m_direct.squeeze();
+    m_slots.clear();
+    m_slots.squeeze();
+    m_base = 0;
+    m_size = 0;
+    m_minId = 0;
+    m_maxId = 0;
+}
+
+qint64 NodeIdMap::memoryUsage() const
+{
+    return qint64(m_direct.size()) * qint64(sizeof(int)) + qint64(m_slots.size()) * qint64(sizeof(Slot));
+}
+
+bool NodeIdMap::denseEnough(long minId, long maxId, int count) const
+{
+    // 跨度减一与上限比较，ID 覆盖整个 long 范围时也不会溢出
+    quint64 limit = quint64(DENSE_FACTOR) * quint64(count) + DENSE_SLACK;
+    return quint64(maxId) - quint64(minId) < qMin(limit, quint64(std::numeric_limits<int>::max() / 2));
+}
+
+void NodeIdMap::insertDirect(long id, int index)
+{
+    quint64 offset = quint64(id) - m_base;
+    if (offset >= quint64(m_direct.size()))
+    {
+        // 容量取新跨度的两倍，两侧各留出空位，逐个递增或递减插入时均摊 O(1)
+        long minId = m_size == 0 ? id : qMin(m_minId, id);
+        long maxId = m_size == 0 ? id : qMax(m_maxId, id);
+        quint64 span = quint64(maxId) - quint64(minId) + 1;
+        int capacity = qMax(int(span) * 2, 64);
+        quint64 base = quint64(minId) - (quint64(capacity) - span) / 2;
+        rebuildDirect(base, capacity);
+        offset = quint64(id) - m_base;
+    }
+    m_direct[int(offset)] = index;
+}
+
+void NodeIdMap::insertSlot(long id, int index)
+{
+    if ((m_size + 1) * 2 > m_slots.size())
+        rehash(m_slots.size() * 2);
+
+    quint64 mask = quint64(m_slots.size()) - 1;
+    quint64 i = hash(id) & mask;
+    while (m_slots[int(i)].index != 0)
+        i = (i + 1) & mask;
+    m_slots[int(i)].id = id;
+    m_slots[int(i)].index = index;
+}
+
+void NodeIdMap::rehash(int capacity)
+{
+    QVector<Slot> old;
+    old.swap(m_slots);
+    m_slots.resize(capacity);
+
+    quint64 mask = quint64(capacity) - 1;
+    for (int k = 0; k < old.size(); k++)
+    {
+        if (old[k].index == 0)
+            continue;
+        quint64 i = hash(old[k].id) & mask;
+        while (m_slots[int(i)].index != 0)
+            i = (i + 1) & mask;
+        m_slots[int(i)] = old[k];
+    }
+}
+
+void NodeIdMap::convertToSlots()
+{
+    int capacity = 16;
+    while (capacity < (m_size + 1) * 2)
+        capacity *= 2;
+    m_slots.clear();
+    m_slots.resize(capacity);
+    m_isDirect = false;
+
+    // insertSlot 按 m_size 判断是否扩容，转换期间容量已足够
+    for (int k = 0; k < m_direct.size(); k++)
+    {
+        if (m_direct[k] != 0)
+            insertSlot(long(m_base + quint64(k)), m_direct[k]);
+    }
+    m_direct.clear();
+    m_direct.squeeze();
+}
+
+void NodeIdMap::rebuildDirect(quint64 base, int capacity)
+{
+    QVector<int> direct(capacity, 0);
+    for (int k = 0; k < m_direct.size(); k++)
+    {
+        if (m_direct[k] != 0)
+            direct[int(m_base + quint64(k) - base)] = m_direct[k];
+    }
+    m_direct.swap(direct);
+    m_base = base;
+}
@@ -0,0 +1,86 @@
+#ifndef DIJKSTRA_IDMAP_H
+#define DIJKSTRA_IDMAP_H
+
+#include <QVector>
+#include <QtGlobal>
+
+// 节点 ID 到内部索引（1..n）的映射
+// ID 连续（如数据文件按 1..N 编号）时用直接数组：index = direct[id - base]，一次访存；
+// 否则用开放寻址的扁平散列表（线性探测，负载不超过 1/2），键和索引放在同一个槽中，查找通常只访问一个缓存行
+// 插入时按 ID 的跨度自动选择：跨度超过 DENSE_FACTOR × 节点数 + DENSE_SLACK 时转为散列表；
+// compact() 在载入完成后（冻结时）重新检查，先出现稀疏 ID、最终仍连续的数据也能改回直接数组
+class NodeIdMap
+{
+public:
+    static const int DENSE_FACTOR = 2;          // 直接数组允许的空位比例
+    static const int DENSE_SLACK = 1024;
+
+    NodeIdMap();
+
+    // ID 对应的索引，不存在时为 0
+    int value(long id) const
+    {
+        if (m_isDirect)
+        {
+            // 无符号减法：id 小于 base 时回绕成很大的偏移，一次比较即可排除
+            quint64 offset = quint64(id) - m_base;
+            return offset < quint64(m_direct.size()) ? m_direct[int(offset)] : 0;
+        }
+
+        quint64 mask = quint64(m_slots.size()) - 1;
+        for (quint64 i = hash(id) & mask;; i = (i + 1) & mask)
+        {
+            const Slot &slot = m_slots[int(i)];
+            if (slot.index == 0)
+                return 0;
+            if (slot.id == id)
+                return slot.index;
+        }
+    }
+    bool contains(long id) const { return value(id) != 0; }
+
+    // 加入新 ID（调用方保证 ID 不存在，index > 0）
+    void insert(long id, int index);
+
+    // ID 足够连续时改用直接数组，直接数组去掉多余的容量
+    void compact();
+
+    void clear();
+
+    int size() const { return m_size; }
+    bool isDirect() const { return m_isDirect; }
+    qint64 memoryUsage() const;
+
+private:
+    struct Slot
+    {
+        long id = 0;
+        int index = 0;              // 0 表示空槽
+    };
+
+    static quint64 hash(long id)
+    {
+        // splitmix64 的混合步骤：连续或等差的 ID 也能均匀分布
+        quint64 x = quint64(id);
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    bool denseEnough(long minId, long maxId, int count) const;
+    void insertDirect(long id, int index);
+    void insertSlot(long id, int index);
+    void rehash(int capacity);
+    void convertToSlots();
+    void rebuildDirect(quint64 base, int capacity);
+
+    bool m_isDirect;
+    QVector<int> m_direct;          // 直接数组：下标为 id - m_base
+    quint64 m_base;                 // 直接数组首个位置对应的 ID（按 64 位无符号回绕运算）
+    QVector<Slot> m_slots;          // 散列表，容量为 2 的幂
+    int m_size;
+    long m_minId;
+    long m_maxId;
+};
+
+#endif // DIJKSTRA_IDMAP_H
@@ -0,0 +1,176 @@
+#include "dijkstra_lanes.h"
+
+namespace {
+
+// 用 du（LANES 路）经 count 条边松弛 targets 的距离向量，距离变小的目标写入 changed，返回其个数
+typedef int (*RelaxArcs)(qint32 *distance, const qint32 *du, const int *targets, const qint32 *weights,
+                         int count, int *changed);
+
+int relaxArcsScalar(qint32 *distance, const qint32 *du, const int *targets, const qint32 *weights,
+                    int count, int *changed)
+{
+    int changedCount = 0;
+    for (int a = 0; a < count; a++)
+    {
+        qint32 *dv = distance + qint64(targets[a]) * LaneBatchSearch::LANES;
+        bool shorter = false;
+        for (int lane = 0; lane < LaneBatchSearch::LANES; lane++)
+        {
+            qint32 nd = du[lane] + weights[a];
+            if (nd < dv[lane])
+            {
+                dv[lane] = nd;
+                shorter = true;
+            }
+        }
+        if (shorter)
+            changed[changedCount++] = targets[a];
+    }
+    return changedCount;
+}
+
+#ifdef DIJKSTRA_SIMD_X86
+DIJKSTRA_TARGET_SSE41
+int relaxArcsSse41(qint32 *distance, const qint32 *du, const int *targets, const qint32 *weights,
+                   int count, int *changed)
+{
+    __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(du));
+    __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(du + 4));
+    int changedCount = 0;
+    for (int a = 0; a < count; a++)
+    {
+        qint32 *dv = distance + qint64(targets[a]) * LaneBatchSearch::LANES;
+        __m128i w = _mm_set1_epi32(weights[a]);
+        __m128i ndLow = _mm_add_epi32(low, w);
+        __m128i ndHigh = _mm_add_epi32(high, w);
+        __m128i oldLow = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dv));
+        __m128i oldHigh = _mm_loadu_si128(reinterpret_cast<const __m128i *>(dv + 4));
+        __m128i shorter = _mm_or_si128(_mm_cmpgt_epi32(oldLow, ndLow), _mm_cmpgt_epi32(oldHigh, ndHigh));
+        if (_mm_testz_si128(shorter, shorter))
+            continue;
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dv), _mm_min_epi32(oldLow, ndLow));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dv + 4), _mm_min_epi32(oldHigh, ndHigh));
+        changed[changedCount++] = targets[a];
+    }
+    return changedCount;
+}
+
+DIJKSTRA_TARGET_AVX2
+int relaxArcsAvx2(qint32 *distance, const qint32 *du, const int *targets, const qint32 *weights,
+                  int count, int *changed)
+{
+    __m256i viaU = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(du));
+    int changedCount = 0;
+    for (int a = 0; a < count; a++)
+    {
+        qint32 *dv = distance + qint64(targets[a]) * LaneBatchSearch::LANES;
+        __m256i nd = _mm256_add_epi32(viaU, _mm256_set1_epi32(weights[a]));
+        __m256i old = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dv));
+        __m256i shorter = _mm256_cmpgt_epi32(old, nd);
+        if (_mm256_testz_si256(shorter, shorter))
+            continue;
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dv), _mm256_min_epi32(old, nd));
+        changed[changedCount++] = targets[a];
+    }
+    return changedCount;
+}
+#endif // DIJKSTRA_SIMD_X86
+
+RelaxArcs relaxArcsFor(SimdCpu::Level level)
+{
+#ifdef DIJKSTRA_SIMD_X86
+    if (level == SimdCpu::LevelAvx2)
+        return relaxArcsAvx2;
+    if (level >= SimdCpu::LevelSse41)
+        return relaxArcsSse41;
+#else
+    Q_UNUSED(level);
+#endif
+    return relaxArcsScalar;
+}
+
+} // namespace
+
+LaneBatchSearch::LaneBatchSearch()
+    : m_graph(nullptr)
+    , m_level(SimdCpu::LevelScalar)
+    , m_scanCount(0)
+{
+}
+
+bool LaneBatchSearch::suitable(const CsrGraph &graph)
+{
+    return graph.nodeCount() > 0 && graph.minWeight >= 0
+        && qint64(graph.maxWeight) * qMax(graph.nodeCount() - 1, 1) < INFINITE_DISTANCE;
+}
+
+bool LaneBatchSearch::init(const CsrGraph &graph)
+{
+    if (!suitable(graph))
+        return false;
+
+    int n = graph.nodeCount();
+    m_graph = &graph;
+    m_level = SimdCpu::detect();
+    m_weights.resize(graph.weights.size());
+    for (int e = 0; e < graph.weights.size(); e++)
+        m_weights[e] = qint32(graph.weights[e]);
+    m_distance.resize(qint64(n + 1) * LANES);
+    m_queued.fill(false, n + 1);
+    m_queue.resize(n + 1);
+    int maxDegree = 0;
+    for (int u = 1; u <= n; u++)
+        maxDegree = qMax(maxDegree, graph.degree(u));
+    m_changed.resize(maxDegree);
+    return true;
+}
+
+void LaneBatchSearch::run(const int *sources, int count)
+{
+    const int *offsets = m_graph->offsets.constData();
+    const int *targets = m_graph->targets.constData();
+    const qint32 *weights = m_weights.constData();
+    qint32 *distance = m_distance.data();
+    bool *queued = m_queued.data();
+    int *queue = m_queue.data();
+    int *changed = m_changed.data();
+    int capacity = m_queue.size();
+    RelaxArcs relax = relaxArcsFor(m_level);
+
+    // 多余的路保持无穷大，不影响其他路
+    m_distance.fill(INFINITE_DISTANCE);
+    int head = 0, size = 0;
+    for (int lane = 0; lane < count; lane++)
+    {
+        int s = sources[lane];
+        distance[qint64(s) * LANES + lane] = 0;
+        if (!queued[s])
+        {
+            queued[s] = true;
+            queue[(head + size++) % capacity] = s;
+        }
+    }
+
+    m_scanCount = 0;
+    while (size > 0)
+    {
+        int u = queue[head];
+        head = (head + 1) % capacity;
+        size--;
+        queued[u] = false;
+        m_scanCount++;
+
+        int begin = offsets[u];
+        int changedCount = relax(distance, distance + qint64(u) * LANES, targets + begin, weights + begin,
+                                 offsets[u + 1] - begin, changed);
+        for (int i = 0; i < changedCount; i++)
+        {
+            int v = changed[i];
+            if (!queued[v])
+            {
+                queued[v] = true;
+                queue[(head + size++) % capacity] = v;
+            }
+        }
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef DIJKSTRA_LANES_H
+#define DIJKSTRA_LANES_H
+
+#include "dijkstra_csr.h"
+#include "dijkstra_simd.h"
+#include <QVector>
+#include <QtGlobal>
+
+// 多个起点同步执行的 SIMD 单源最短路：每个节点的暂定距离是一个 8 路 32 位向量（每路一个起点），
+// 一条边的松弛是一次向量加法与取最小值，8 个搜索共用同一次邻接表遍历
+// 采用标号修正（Bellman-Ford-Moore）调度：任一路距离变小的节点进入先进先出工作队列，已在队列中的不重复加入
+// 按运行时检测到的指令集选择 AVX2（一个 256 位向量）、SSE4.1（两个 128 位向量）或标量实现
+// 一次计算起点到全部节点的距离，不提前结束，适合终点很多的多对多计算
+class LaneBatchSearch
+{
+public:
+    static const int LANES = 8;
+
+    LaneBatchSearch();
+
+    // 边权非负且最大可能距离在 32 位内时可用
+    static bool suitable(const CsrGraph &graph);
+
+    // 为 graph 准备 32 位边权与距离数组；不满足 suitable 时返回 false
+    bool init(const CsrGraph &graph);
+
+    // 从 sources[0..count) 同时出发（count <= LANES，节点索引 1..n）
+    void run(const int *sources, int count);
+
+    // 第 lane 个起点到 node 的距离，不可达为 CsrGraph::UNREACHABLE
+    long distance(int node, int lane) const
+    {
+        qint32 d = m_distance[qint64(node) * LANES + lane];
+        return d >= INFINITE_DISTANCE ? CsrGraph::UNREACHABLE : long(d);
+    }
+
+    SimdCpu::Level level() const { return m_level; }
+
+    // 最近一次运行中出队（扫描邻接表）的节点数
+    qint64 scanCount() const { return m_scanCount; }
+
+private:
+    static constexpr qint32 INFINITE_DISTANCE = 0x3FFFFFFF;
+
+    const CsrGraph *m_graph;
+    QVector<qint32> m_weights;      // CSR 边权的 32 位副本
+    QVector<qint32> m_distance;     // (n + 1) × LANES
+    QVector<bool> m_queued;         // 节点是否已在工作队列中
+    QVector<int> m_queue;           // 循环工作队列，容量 n + 1
+    QVector<int> m_changed;         // 一个节点松弛后距离变小的邻居
+    SimdCpu::Level m_level;
+    qint64 m_scanCount;
+};
+
+#endif // DIJKSTRA_LANES_H
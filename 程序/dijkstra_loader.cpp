@@ -1,5 +1,6 @@
 #include "dijkstra_loader.h"
 #include "dijkstra.h"
+#include "graphdatabase.h"
 #include <QFile>
 #include <QTextStream>
 #include <QStringList>
@@ -93,10 +94,33 @@ void FileLoaderWorker::load()
     }
 
     file.close();
+    m_dijkstra->freeze();
+    m_dijkstra->setHubLabelFile(m_fileName + ".hub");
     emit progress(1.0f);
     emit finished(true, "");
 }
 
+// ==================== DatabaseLoaderWorker 实现 ====================
+
+DatabaseLoaderWorker::DatabaseLoaderWorker(Dijkstra *dijkstra, const QString &dbPath, const QString &tableName)
+    : m_dijkstra(dijkstra)
+    , m_dbPath(dbPath)
+    , m_tableName(tableName)
+{
+}
+
+void DatabaseLoaderWorker::load()
+{
+    // 连接在本线程中创建和关闭
+    GraphDatabase db;
+    if (!db.initialize(m_dbPath) || !db.loadGraph(m_dijkstra, m_tableName))
+    {
+        emit finished(false, db.lastError());
+        return;
+    }
+    emit finished(true, "");
+}
+
 // ==================== DijkstraLoader 实现 ====================
 
 DijkstraLoader::DijkstraLoader(QObject *parent)
@@ -112,25 +136,47 @@ DijkstraLoader::~DijkstraLoader()
     cancel();
 }
 
-void DijkstraLoader::loadFile(Dijkstra *dijkstra, const QString &fileName)
+void DijkstraLoader::loadFile(const QString &fileName, const QSharedPointer<Dijkstra> &graph)
 {
     // 取消之前的加载
     cancel();
 
     m_cancelled = false;
     m_fileName = fileName;
+    m_tableName.clear();
+    m_graph = graph;
+
+    FileLoaderWorker *worker = new FileLoaderWorker(m_graph.data(), fileName);
+    connect(worker, &FileLoaderWorker::progress, this, &DijkstraLoader::progress);
+    connect(worker, &FileLoaderWorker::lineProcessed, this, &DijkstraLoader::lineProcessed);
+    start(worker);
+}
 
+void DijkstraLoader::loadTable(const QString &dbPath, const QString &tableName, const QSharedPointer<Dijkstra> &graph)
+{
+    // 取消之前的加载
+    cancel();
+
+    m_cancelled = false;
+    m_fileName = dbPath;
+    m_tableName = tableName;
+    m_graph = graph;
+
+    start(new DatabaseLoaderWorker(m_graph.data(), dbPath, tableName));
+}
+
+template <typename Worker>
+void DijkstraLoader::start(Worker *worker)
+{
     // 创建新线程
     m_thread = new QThread(this);
-    m_worker = new FileLoaderWorker(dijkstra, fileName);
+    m_worker = worker;
 
-    m_worker->moveToThread(m_thread);
+    worker->moveToThread(m_thread);
 
     // 连接信号
-    connect(m_thread, &QThread::started, m_worker, &FileLoaderWorker::load);
-    connect(m_worker, &FileLoaderWorker::finished, this, &DijkstraLoader::onWorkerFinished);
-    connect(m_worker, &FileLoaderWorker::progress, this, &DijkstraLoader::progress);
-    connect(m_worker, &FileLoaderWorker::lineProcessed, this, &DijkstraLoader::lineProcessed);
+    connect(m_thread, &QThread::started, worker, &Worker::load);
+    connect(worker, &Worker::finished, this, &DijkstraLoader::onWorkerFinished);
 
     // 启动线程
     m_thread->start();
@@ -161,6 +207,17 @@ void DijkstraLoader::cancel()
         delete m_thread;
         m_thread = nullptr;
     }
+
+    if (m_cancelled)
+        m_graph.reset();
+}
+
+QSharedPointer<Dijkstra> DijkstraLoader::takeLoadedGraph()
+{
+    QSharedPointer<Dijkstra> graph;
+    if (!m_thread)
+        graph.swap(m_graph);
+    return graph;
 }
 
 void DijkstraLoader::onWorkerFinished(bool success, const QString &error)
@@ -179,6 +236,8 @@ void DijkstraLoader::onWorkerFinished(bool success, const QString &error)
         m_worker = nullptr;
     }
 
+    if (!success)
+        m_graph.reset();
     emit finished(success, error);
 }
 
@@ -2,6 +2,7 @@
 #define DIJKSTRA_LOADER_H
 
 #include <QObject>
+#include <QSharedPointer>
 #include <QThread>
 #include <QString>
 #include <functional>
@@ -29,7 +30,28 @@ private:
     QString m_fileName;
 };
 
-// 文件加载器（管理线程）
+// 数据表加载工作线程：数据库连接只能在创建它的线程中使用，工作线程打开自己的连接读取表格
+class DatabaseLoaderWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    DatabaseLoaderWorker(Dijkstra *dijkstra, const QString &dbPath, const QString &tableName);
+
+public slots:
+    void load();
+
+signals:
+    void finished(bool success, const QString &error);
+
+private:
+    Dijkstra *m_dijkstra;
+    QString m_dbPath;
+    QString m_tableName;
+};
+
+// 文件和数据表加载器（管理线程）
+// 每次加载在调用方新建的 Dijkstra 实例中进行，正在使用的图不受影响；成功后由调用方用 takeLoadedGraph() 取走并发布
 class DijkstraLoader : public QObject
 {
     Q_OBJECT
@@ -38,9 +60,15 @@ public:
     explicit DijkstraLoader(QObject *parent = nullptr);
     ~DijkstraLoader();
 
-    void loadFile(Dijkstra *dijkstra, const QString &fileName);
+    // graph 为新建的空图（带有要沿用的设置），加载在其中进行
+    void loadFile(const QString &fileName, const QSharedPointer<Dijkstra> &graph);
+    // 从数据库文件 dbPath 的表格 tableName 加载（同 GraphDatabase::loadGraph），完成后发出 finished
+    void loadTable(const QString &dbPath, const QString &tableName, const QSharedPointer<Dijkstra> &graph);
     void cancel();
     QString getFileName() const { return m_fileName; }
+    QString getTableName() const { return m_tableName; }
+    // 取走成功加载的图（finished(true) 之后有效），加载器不再持有它
+    QSharedPointer<Dijkstra> takeLoadedGraph();
 
 signals:
     void progress(float percent);
@@ -51,10 +79,16 @@ private slots:
     void onWorkerFinished(bool success, const QString &error);
 
 private:
+    // 在新线程中运行 worker 的 load()
+    template <typename Worker>
+    void start(Worker *worker);
+
     QThread *m_thread;
-    FileLoaderWorker *m_worker;
+    QObject *m_worker;
     bool m_cancelled;
     QString m_fileName;
+    QString m_tableName;
+    QSharedPointer<Dijkstra> m_graph;   // 正在加载或已加载完成的新图
 };
 
 #endif // DIJKSTRA_LOADER_H
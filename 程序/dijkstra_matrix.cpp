@@ -0,0 +1,399 @@
+#include "dijkstra_matrix.h"
+#include "dijkstra_heap.h"
+#include "dijkstra_bfs.h"
+#include "dijkstra_lanes.h"
+#include <QAtomicInteger>
+#include <QThread>
+#include <QtConcurrent>
+#include <algorithm>
+
+namespace {
+
+// 终点数不少于节点数的 1 / LANE_MIN_TARGET_DIVISOR 时自动选择 SIMD 批量搜索
+const int LANE_MIN_TARGET_DIVISOR = 16;
+
+// 单个线程的搜索工作区，只复位被访问过的节点
+// 队列按边权统计选择（与 Dijkstra 的 QueueAuto 相同），惰性队列中的过期条目出队时跳过
+template <typename Queue>
+struct RowSearch
+{
+    QVector<long> distance;
+    QVector<int> parent;
+    QVector<bool> settled;
+    QVector<int> touched;
+    Queue heap;
+    int settledCount = 0;
+
+    void init(const CsrGraph &graph)
+    {
+        int nodeCount = graph.nodeCount();
+        distance.fill(CsrGraph::UNREACHABLE, nodeCount + 1);
+        parent.fill(0, nodeCount + 1);
+        settled.fill(false, nodeCount + 1);
+        setMaxWeight(heap, graph.maxWeight);
+    }
+
+    static void setMaxWeight(DialQueue &queue, long maxWeight) { queue.setMaxWeight(maxWeight); }
+    template <typename Other>
+    static void setMaxWeight(Other &, long) {}
+
+    // 从 source 出发，直到 targetCount 个不同的终点（isTarget 标记）都已确定
+    void run(const CsrGraph &graph, const QVector<bool> &isTarget, int targetCount, int source)
+    {
+        const int *offsets = graph.offsets.constData();
+        const int *targets = graph.targets.constData();
+        const long *weights = graph.weights.constData();
+
+        for (int i = 0; i < touched.size(); i++)
+        {
+            distance[touched[i]] = CsrGraph::UNREACHABLE;
+            parent[touched[i]] = 0;
+            settled[touched[i]] = false;
+        }
+        touched.clear();
+        settledCount = 0;
+
+        heap.reset(graph.nodeCount());
+        distance[source] = 0;
+        touched.append(source);
+        heap.push(source, 0);
+
+        int remaining = targetCount;
+        while (!heap.isEmpty() && remaining > 0)
+        {
+            long d;
+            int u = heap.pop(d);
+            if (settled[u])
+                continue;
+            settled[u] = true;
+            settledCount++;
+            if (isTarget[u])
+                remaining--;
+
+            for (int e = offsets[u]; e < offsets[u + 1]; e++)
+            {
+                int v = targets[e];
+                if (settled[v])
+                    continue;
+                long nd = d + weights[e];
+                if (nd < distance[v])
+                {
+                    if (distance[v] == CsrGraph::UNREACHABLE)
+                        touched.append(v);
+                    distance[v] = nd;
+                    parent[v] = u;
+                    heap.push(v, nd);
+                }
+            }
+        }
+    }
+};
+
+// 一次矩阵计算的输入与输出位置，各线程只读输入、写入互不重叠的行和路径
+struct MatrixJob
+{
+    const CsrGraph *graph;
+    const QVector<int> *sources;
+    const QVector<int> *targets;
+    const QVector<QPair<int, int>> *pathPairs;
+    QVector<bool> isTarget;             // 终点标记
+    int targetCount;                    // 不同终点的个数
+    QVector<QVector<int>> rowRequests;  // 每行的路径请求编号
+    long *out;
+    QVector<int> *paths;
+};
+
+// 各线程动态领取起点，返回全部搜索确定的节点数
+template <typename Queue>
+qint64 searchRows(const MatrixJob &job, int threadCount)
+{
+    int rows = job.sources->size();
+    int columns = job.targets->size();
+
+    QVector<RowSearch<Queue>> searches(threadCount);
+    QVector<qint64> settledCounts(threadCount, 0);
+    QVector<int> workers;
+    for (int w = 0; w < threadCount; w++)
+        workers.append(w);
+
+    QAtomicInt nextRow(0);
+    RowSearch<Queue> *workspaces = searches.data();
+    qint64 *settledOut = settledCounts.data();
+    QtConcurrent::blockingMap(workers, [&job, &nextRow, workspaces, settledOut, rows, columns](int worker) {
+        const QVector<int> &sources = *job.sources;
+        const QVector<int> &targets = *job.targets;
+        RowSearch<Queue> &search = workspaces[worker];
+        search.init(*job.graph);
+        for (int row = nextRow.fetchAndAddRelaxed(1); row < rows; row = nextRow.fetchAndAddRelaxed(1))
+        {
+            search.run(*job.graph, job.isTarget, job.targetCount, sources[row]);
+            settledOut[worker] += search.settledCount;
+
+            long *line = job.out + qint64(row) * columns;
+            for (int j = 0; j < columns; j++)
+                line[j] = search.distance[targets[j]];
+
+            const QVector<int> &requests = job.rowRequests.at(row);
+            for (int k = 0; k < requests.size(); k++)
+            {
+                int target = targets[job.pathPairs->at(requests[k]).second];
+                QVector<int> &path = job.paths[requests[k]];
+                if (search.distance[target] >= CsrGraph::UNREACHABLE)
+                    continue;
+                for (int node = target; node != sources[row]; node = search.parent[node])
+                    path.append(node);
+                path.append(sources[row]);
+                std::reverse(path.begin(), path.end());
+            }
+        }
+    });
+
+    qint64 settled = 0;
+    for (int w = 0; w < threadCount; w++)
+        settled += settledCounts[w];
+    return settled;
+}
+
+// 批量引擎不记录前驱：有路径请求的行另做一次单源搜索回溯路径
+void tracePaths(const MatrixJob &job, int row, QVector<long> &distance, QVector<int> &parent)
+{
+    const QVector<int> &requests = job.rowRequests.at(row);
+    if (requests.isEmpty())
+        return;
+
+    int source = job.sources->at(row);
+    job.graph->shortestPaths(source, distance, &parent);
+    for (int k = 0; k < requests.size(); k++)
+    {
+        int target = job.targets->at(job.pathPairs->at(requests[k]).second);
+        QVector<int> &path = job.paths[requests[k]];
+        if (distance[target] >= CsrGraph::UNREACHABLE)
+            continue;
+        for (int node = target; node != source; node = parent[node])
+            path.append(node);
+        path.append(source);
+        std::reverse(path.begin(), path.end());
+    }
+}
+
+// 全部边权相同时每 64 个起点做一次位并行 BFS，各线程动态领取批次，返回扩展的节点数
+qint64 bfsRows(const MatrixJob &job, int threadCount)
+{
+    const CsrGraph &graph = *job.graph;
+    const QVector<int> &sources = *job.sources;
+    const QVector<int> &targets = *job.targets;
+    int rows = sources.size();
+    int columns = targets.size();
+
+    // 重复的终点共用一个结果位置
+    QVector<int> slot(graph.nodeCount() + 1, -1);
+    int slotCount = 0;
+    for (int j = 0; j < columns; j++)
+    {
+        if (slot[targets[j]] < 0)
+            slot[targets[j]] = slotCount++;
+    }
+
+    int batches = (rows + MultiSourceBfs::BATCH - 1) / MultiSourceBfs::BATCH;
+    threadCount = qMin(threadCount, batches);
+    QVector<qint64> expandedCounts(threadCount, 0);
+    QVector<int> workers;
+    for (int w = 0; w < threadCount; w++)
+        workers.append(w);
+
+    QAtomicInt nextBatch(0);
+    qint64 *expandedOut = expandedCounts.data();
+    QtConcurrent::blockingMap(workers, [&job, &graph, &sources, &targets, &slot, &nextBatch, expandedOut,
+                                        slotCount, batches, rows, columns](int worker) {
+        MultiSourceBfs bfs;
+        QVector<long> distance;
+        QVector<int> parent;
+        for (int batch = nextBatch.fetchAndAddRelaxed(1); batch < batches; batch = nextBatch.fetchAndAddRelaxed(1))
+        {
+            int first = batch * MultiSourceBfs::BATCH;
+            int count = qMin(MultiSourceBfs::BATCH, rows - first);
+            bfs.run(graph, sources.constData() + first, count, slot, slotCount);
+            expandedOut[worker] += bfs.expandedCount();
+
+            for (int lane = 0; lane < count; lane++)
+            {
+                int row = first + lane;
+                long *line = job.out + qint64(row) * columns;
+                for (int j = 0; j < columns; j++)
+                    line[j] = bfs.distance(slot[targets[j]], lane);
+                tracePaths(job, row, distance, parent);
+            }
+        }
+    });
+
+    qint64 expanded = 0;
+    for (int w = 0; w < threadCount; w++)
+        expanded += expandedCounts[w];
+    return expanded;
+}
+
+// 每 8 个起点一批的 SIMD 标号修正搜索，各线程动态领取批次，返回出队的节点数
+qint64 laneRows(const MatrixJob &job, int threadCount)
+{
+    const QVector<int> &sources = *job.sources;
+    const QVector<int> &targets = *job.targets;
+    int rows = sources.size();
+    int columns = targets.size();
+
+    int batches = (rows + LaneBatchSearch::LANES - 1) / LaneBatchSearch::LANES;
+    threadCount = qMin(threadCount, batches);
+    QVector<qint64> scanCounts(threadCount, 0);
+    QVector<int> workers;
+    for (int w = 0; w < threadCount; w++)
+        workers.append(w);
+
+    QAtomicInt nextBatch(0);
+    qint64 *scanOut = scanCounts.data();
+    QtConcurrent::blockingMap(workers, [&job, &sources, &targets, &nextBatch, scanOut, batches, rows,
+                                        columns](int worker) {
+        LaneBatchSearch search;
+        search.init(*job.graph);
+        QVector<long> distance;
+        QVector<int> parent;
+        for (int batch = nextBatch.fetchAndAddRelaxed(1); batch < batches; batch = nextBatch.fetchAndAddRelaxed(1))
+        {
+            int first = batch * LaneBatchSearch::LANES;
+            int count = qMin(LaneBatchSearch::LANES, rows - first);
+            search.run(sources.constData() + first, count);
+            scanOut[worker] += search.scanCount();
+
+            for (int lane = 0; lane < count; lane++)
+            {
+                int row = first + lane;
+                long *line = job.out + qint64(row) * columns;
+                for (int j = 0; j < columns; j++)
+                    line[j] = search.distance(targets[j], lane);
+                tracePaths(job, row, distance, parent);
+            }
+        }
+    });
+
+    qint64 scanned = 0;
+    for (int w = 0; w < threadCount; w++)
+        scanned += scanCounts[w];
+    return scanned;
+}
+
+} // namespace
+
+DistanceMatrix::DistanceMatrix()
+    : m_method(MethodAuto)
+    , m_usedMethod(MethodAuto)
+    , m_rows(0)
+    , m_columns(0)
+    , m_settledCount(0)
+{
+}
+
+bool DistanceMatrix::compute(const CsrGraph &graph, const QVector<int> &sources, const QVector<int> &targets,
+                             const QVector<QPair<int, int>> &pathPairs, int threadCount)
+{
+    clear();
+
+    int n = graph.nodeCount();
+    for (int i = 0; i < sources.size(); i++)
+    {
+        if (sources[i] < 1 || sources[i] > n)
+            return false;
+    }
+    for (int j = 0; j < targets.size(); j++)
+    {
+        if (targets[j] < 1 || targets[j] > n)
+            return false;
+    }
+    for (int k = 0; k < pathPairs.size(); k++)
+    {
+        if (pathPairs[k].first < 0 || pathPairs[k].first >= sources.size()
+            || pathPairs[k].second < 0 || pathPairs[k].second >= targets.size())
+            return false;
+    }
+
+    m_rows = sources.size();
+    m_columns = targets.size();
+    m_distances.fill(CsrGraph::UNREACHABLE, qint64(m_rows) * m_columns);
+    m_paths.resize(pathPairs.size());
+    if (m_rows == 0 || m_columns == 0)
+        return true;
+
+    MatrixJob job;
+    job.graph = &graph;
+    job.sources = &sources;
+    job.targets = &targets;
+    job.pathPairs = &pathPairs;
+    job.out = m_distances.data();
+    job.paths = m_paths.data();
+
+    // 终点去重计数，搜索据此判断何时停止
+    job.isTarget.fill(false, n + 1);
+    job.targetCount = 0;
+    for (int j = 0; j < m_columns; j++)
+    {
+        if (!job.isTarget[targets[j]])
+        {
+            job.isTarget[targets[j]] = true;
+            job.targetCount++;
+        }
+    }
+
+    // 路径请求按行分组
+    job.rowRequests.resize(m_rows);
+    for (int k = 0; k < pathPairs.size(); k++)
+        job.rowRequests[pathPairs[k].first].append(k);
+
+    if (threadCount <= 0)
+        threadCount = QThread::idealThreadCount();
+    threadCount = qMin(threadCount, m_rows);
+
+    m_usedMethod = chooseMethod(graph, m_rows, job.targetCount);
+    if (m_usedMethod == MethodBfs)
+        m_settledCount = bfsRows(job, threadCount);
+    else if (m_usedMethod == MethodLanes)
+        m_settledCount = laneRows(job, threadCount);
+    else if (graph.minWeight < 0)
+        m_settledCount = searchRows<DaryHeap<4>>(job, threadCount);
+    else if (graph.maxWeight <= DialQueue::MAX_WEIGHT)
+        m_settledCount = searchRows<DialQueue>(job, threadCount);
+    else
+        m_settledCount = searchRows<RadixHeap>(job, threadCount);
+    return true;
+}
+
+DistanceMatrix::Method DistanceMatrix::chooseMethod(const CsrGraph &graph, int rows, int targetCount) const
+{
+    bool bfs = graph.uniformWeight() > 0;
+    bool lanes = LaneBatchSearch::suitable(graph);
+    switch (m_method)
+    {
+    case MethodBfs:
+        return bfs ? MethodBfs : MethodDijkstra;
+    case MethodLanes:
+        return lanes ? MethodLanes : MethodDijkstra;
+    case MethodDijkstra:
+        return MethodDijkstra;
+    case MethodAuto:
+    default:
+        break;
+    }
+
+    if (bfs)
+        return MethodBfs;
+    // 批量搜索总要算到全部节点，终点占比足够大、行数凑得满一批时才比逐行提前终止的 Dijkstra 快
+    if (lanes && rows >= LaneBatchSearch::LANES
+        && qint64(targetCount) * LANE_MIN_TARGET_DIVISOR >= graph.nodeCount())
+        return MethodLanes;
+    return MethodDijkstra;
+}
+
+void DistanceMatrix::clear()
+{
+    m_distances.clear();
+    m_paths.clear();
+    m_rows = 0;
+    m_columns = 0;
+    m_settledCount = 0;
+}
@@ -0,0 +1,67 @@
+#ifndef DIJKSTRA_MATRIX_H
+#define DIJKSTRA_MATRIX_H
+
+#include "dijkstra_csr.h"
+#include <QPair>
+#include <QVector>
+#include <QtGlobal>
+
+// 一对多 / 多对多距离矩阵
+// 每个起点做一次 Dijkstra，全部终点确定后即停止；各起点分配到不同线程（QtConcurrent），
+// 每个线程使用自己的工作区，只复位被访问过的节点
+// 全部边权相同的图改为每 64 个起点一批的位并行 BFS（MultiSourceBfs）；
+// 终点很多时改为每 8 个起点一批的 SIMD 标号修正搜索（LaneBatchSearch），一次算出到全部节点的距离
+// 结果按行优先存放：第 i 行第 j 列为 sources[i] 到 targets[j] 的距离
+class DistanceMatrix
+{
+public:
+    // 每行的计算方式
+    enum Method {
+        MethodAuto,         // 按图和终点数自动选择（默认）
+        MethodDijkstra,     // 每个起点一次 Dijkstra，终点全部确定后停止
+        MethodBfs,          // 位并行多源 BFS（全部边权相同）
+        MethodLanes         // 8 路 SIMD 批量搜索（非负边权，距离在 32 位内）
+    };
+
+    DistanceMatrix();
+
+    // 指定的方式不适用于当前图时退回 Dijkstra
+    void setMethod(Method method) { m_method = method; }
+    Method method() const { return m_method; }
+    // 最近一次 compute 实际使用的方式
+    Method usedMethod() const { return m_usedMethod; }
+
+    // sources/targets 为节点索引；pathPairs 中的每个（行, 列）额外记录一条路径
+    // threadCount <= 0 时使用 QThread::idealThreadCount()
+    bool compute(const CsrGraph &graph, const QVector<int> &sources, const QVector<int> &targets,
+                 const QVector<QPair<int, int>> &pathPairs = QVector<QPair<int, int>>(),
+                 int threadCount = 0);
+
+    void clear();
+
+    int rowCount() const { return m_rows; }
+    int columnCount() const { return m_columns; }
+
+    // 不可达为 CsrGraph::UNREACHABLE
+    long distance(int row, int column) const { return m_distances[qint64(row) * m_columns + column]; }
+    const QVector<long> &distances() const { return m_distances; }
+
+    // 第 request 个路径请求的节点索引（起点到终点），不可达时为空
+    const QVector<int> &path(int request) const { return m_paths[request]; }
+
+    // 全部搜索确定的节点总数（批量引擎为各批次扩展或出队的节点数）
+    qint64 settledCount() const { return m_settledCount; }
+
+private:
+    Method chooseMethod(const CsrGraph &graph, int rows, int targetCount) const;
+
+    Method m_method;
+    Method m_usedMethod;
+    QVector<long> m_distances;      // m_rows × m_columns
+    QVector<QVector<int>> m_paths;  // 与 pathPairs 一一对应
+    int m_rows;
+    int m_columns;
+    qint64 m_settledCount;
+};
+
+#endif // DIJKSTRA_MATRIX_H
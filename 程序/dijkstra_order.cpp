@@ -0,0 +1,258 @@
+#include "dijkstra_order.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 从 start 广度优先遍历所在连通分量（只经过 level 为 -1 的节点），返回离 start 最远的一层
+// level 记录层数，调用方负责在下一次遍历前把访问过的节点（visitedOut）复位
+QVector<int> farthestLevel(const CsrGraph &graph, int start, QVector<int> &level, QVector<int> &visitedOut)
+{
+    const int *offsets = graph.offsets.constData();
+    const int *targets = graph.targets.constData();
+
+    visitedOut.clear();
+    visitedOut.append(start);
+    level[start] = 0;
+    int lastLevelBegin = 0;
+    for (int head = 0; head < visitedOut.size(); head++)
+    {
+        int u = visitedOut[head];
+        if (level[u] != level[visitedOut[lastLevelBegin]])
+            lastLevelBegin = head;
+        for (int e = offsets[u]; e < offsets[u + 1]; e++)
+        {
+            int v = targets[e];
+            if (level[v] < 0)
+            {
+                level[v] = level[u] + 1;
+                visitedOut.append(v);
+            }
+        }
+    }
+    return visitedOut.mid(lastLevelBegin);
+}
+
+int degree(const CsrGraph &graph, int node)
+{
+    return graph.offsets[node + 1] - graph.offsets[node];
+}
+
+// Hilbert 曲线上 (x, y) 的序号，坐标范围 [0, side)，side 为 2 的幂
+quint64 hilbertIndex(quint32 side, quint32 x, quint32 y)
+{
+    quint64 index = 0;
+    for (quint32 s = side / 2; s > 0; s /= 2)
+    {
+        quint32 rx = (x & s) ? 1 : 0;
+        quint32 ry = (y & s) ? 1 : 0;
+        index += quint64(s) * s * ((3 * rx) ^ ry);
+        // 旋转象限，使下一层的子曲线方向一致
+        if (ry == 0)
+        {
+            if (rx == 1)
+            {
+                x = side - 1 - x;
+                y = side - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return index;
+}
+
+} // namespace
+
+QVector<int> NodeOrdering::compute(Method method, const CsrGraph &graph, const QHash<int, QPointF> &coordinates)
+{
+    switch (method)
+    {
+    case Bfs:
+        return bfsOrder(graph);
+    case ReverseCuthillMcKee:
+        return reverseCuthillMcKee(graph);
+    case Hilbert:
+        return hilbertOrder(graph, coordinates);
+    case None:
+    default:
+        break;
+    }
+
+    QVector<int> order(graph.nodeCount());
+    for (int k = 0; k < order.size(); k++)
+        order[k] = k + 1;
+    return order;
+}
+
+double NodeOrdering::averageEdgeSpan(const CsrGraph &graph)
+{
+    int n = graph.nodeCount();
+    qint64 total = 0;
+    for (int u = 1; u <= n; u++)
+    {
+        for (int e = graph.offsets[u]; e < graph.offsets[u + 1]; e++)
+            total += qAbs(graph.targets[e] - u);
+    }
+    return graph.targets.isEmpty() ? 0.0 : double(total) / graph.targets.size();
+}
+
+const char *NodeOrdering::name(Method method)
+{
+    switch (method)
+    {
+    case Bfs:                 return "BFS";
+    case ReverseCuthillMcKee: return "RCM";
+    case Hilbert:             return "Hilbert";
+    case None:
+    default:                  return "原顺序";
+    }
+}
+
+QVector<int> NodeOrdering::bfsOrder(const CsrGraph &graph)
+{
+    int n = graph.nodeCount();
+    const int *offsets = graph.offsets.constData();
+    const int *targets = graph.targets.constData();
+
+    QVector<int> order;
+    order.reserve(n);
+    QVector<bool> visited(n + 1, false);
+    for (int root = 1; root <= n; root++)
+    {
+        if (visited[root])
+            continue;
+        visited[root] = true;
+        order.append(root);
+        for (int head = order.size() - 1; head < order.size(); head++)
+        {
+            int u = order[head];
+            for (int e = offsets[u]; e < offsets[u + 1]; e++)
+            {
+                int v = targets[e];
+                if (!visited[v])
+                {
+                    visited[v] = true;
+                    order.append(v);
+                }
+            }
+        }
+    }
+    return order;
+}
+
+QVector<int> NodeOrdering::reverseCuthillMcKee(const CsrGraph &graph)
+{
+    int n = graph.nodeCount();
+    const int *offsets = graph.offsets.constData();
+    const int *targets = graph.targets.constData();
+
+    // 各连通分量按度数最小的未访问节点依次开始
+    QVector<int> byDegree(n);
+    for (int k = 0; k < n; k++)
+        byDegree[k] = k + 1;
+    std::stable_sort(byDegree.begin(), byDegree.end(), [&graph](int a, int b) {
+        return degree(graph, a) < degree(graph, b);
+    });
+
+    QVector<int> order;
+    order.reserve(n);
+    QVector<bool> visited(n + 1, false);
+    QVector<int> level(n + 1, -1);
+    QVector<int> component;
+    QVector<int> neighbours;
+    for (int candidate : byDegree)
+    {
+        if (visited[candidate])
+            continue;
+
+        // 伪外围节点（George–Liu）：反复从最远一层中度数最小的节点出发，直到离心率不再增加
+        int start = candidate;
+        int eccentricity = -1;
+        for (int round = 0; round < 8; round++)
+        {
+            QVector<int> last = farthestLevel(graph, start, level, component);
+            int depth = level[last.first()];
+            for (int v : component)
+                level[v] = -1;
+            if (depth <= eccentricity)
+                break;
+            eccentricity = depth;
+            start = *std::min_element(last.constBegin(), last.constEnd(), [&graph](int a, int b) {
+                return degree(graph, a) < degree(graph, b);
+            });
+        }
+
+        visited[start] = true;
+        order.append(start);
+        for (int head = order.size() - 1; head < order.size(); head++)
+        {
+            int u = order[head];
+            neighbours.clear();
+            for (int e = offsets[u]; e < offsets[u + 1]; e++)
+            {
+                int v = targets[e];
+                if (!visited[v])
+                {
+                    visited[v] = true;
+                    neighbours.append(v);
+                }
+            }
+            std::stable_sort(neighbours.begin(), neighbours.end(), [&graph](int a, int b) {
+                return degree(graph, a) < degree(graph, b);
+            });
+            order.append(neighbours);
+        }
+    }
+
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+QVector<int> NodeOrdering::hilbertOrder(const CsrGraph &graph, const QHash<int, QPointF> &coordinates)
+{
+    int n = graph.nodeCount();
+    double minX = 0, minY = 0, maxX = 0, maxY = 0;
+    bool first = true;
+    for (auto it = coordinates.constBegin(); it != coordinates.constEnd(); ++it)
+    {
+        if (it.key() < 1 || it.key() > n)
+            continue;
+        const QPointF &p = it.value();
+        minX = first ? p.x() : qMin(minX, p.x());
+        maxX = first ? p.x() : qMax(maxX, p.x());
+        minY = first ? p.y() : qMin(minY, p.y());
+        maxY = first ? p.y() : qMax(maxY, p.y());
+        first = false;
+    }
+
+    // 坐标按较长的一边等比缩放到 2^16 × 2^16 的网格
+    const quint32 side = 1u << 16;
+    double extent = qMax(maxX - minX, maxY - minY);
+    double scale = extent > 0 ? (side - 1) / extent : 0.0;
+
+    QVector<QPair<quint64, int>> keyed;
+    QVector<int> rest;
+    keyed.reserve(coordinates.size());
+    for (int v = 1; v <= n; v++)
+    {
+        auto it = coordinates.constFind(v);
+        if (it == coordinates.constEnd())
+        {
+            rest.append(v);
+            continue;
+        }
+        quint32 x = quint32(std::lround((it.value().x() - minX) * scale));
+        quint32 y = quint32(std::lround((it.value().y() - minY) * scale));
+        keyed.append(qMakePair(hilbertIndex(side, x, y), v));
+    }
+    std::stable_sort(keyed.begin(), keyed.end(), [](const QPair<quint64, int> &a, const QPair<quint64, int> &b) {
+        return a.first < b.first;
+    });
+
+    QVector<int> order;
+    order.reserve(n);
+    for (const auto &item : keyed)
+        order.append(item.second);
+    order.append(rest);
+    return order;
+}
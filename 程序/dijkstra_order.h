@@ -0,0 +1,41 @@
+#ifndef DIJKSTRA_ORDER_H
+#define DIJKSTRA_ORDER_H
+
+#include "dijkstra_csr.h"
+#include <QHash>
+#include <QPointF>
+#include <QVector>
+#include <QtGlobal>
+
+// 冻结时的节点重排：按访问局部性重新编号节点，使相邻节点的索引接近，松弛时的逐节点状态落在相近的缓存行
+//   Bfs                   按广度优先的访问顺序编号（每个连通分量从索引最小的节点开始）
+//   ReverseCuthillMcKee   反向 Cuthill–McKee：从伪外围节点出发广度优先，邻居按度数升序，最后整体反转，带宽更小
+//   Hilbert               按坐标在 Hilbert 曲线上的位置编号，没有坐标的节点按原顺序排在后面
+// 顺序只取决于图（和坐标），重复载入同一数据得到相同的编号
+class NodeOrdering
+{
+public:
+    enum Method {
+        None,
+        Bfs,
+        ReverseCuthillMcKee,
+        Hilbert
+    };
+
+    // 计算新顺序：返回的 order[k] 为新索引 k + 1 的节点的原索引（大小为 n）
+    // coordinates 按原索引给出节点坐标，只有 Hilbert 使用；Method 为 None 时返回原顺序
+    static QVector<int> compute(Method method, const CsrGraph &graph,
+                                const QHash<int, QPointF> &coordinates = QHash<int, QPointF>());
+
+    // 平均边跨度：每条边两端索引之差的平均值，越小访问越集中
+    static double averageEdgeSpan(const CsrGraph &graph);
+
+    static const char *name(Method method);
+
+private:
+    static QVector<int> bfsOrder(const CsrGraph &graph);
+    static QVector<int> reverseCuthillMcKee(const CsrGraph &graph);
+    static QVector<int> hilbertOrder(const CsrGraph &graph, const QHash<int, QPointF> &coordinates);
+};
+
+#endif // DIJKSTRA_ORDER_H
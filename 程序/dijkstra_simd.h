@@ -0,0 +1,115 @@
+#ifndef DIJKSTRA_SIMD_H
+#define DIJKSTRA_SIMD_H
+
+#include <QtGlobal>
+
+// 向量化内核共用的指令集检测
+// x86 上按运行时检测到的 CPU 特性选择 AVX2 / SSE2 实现，其他架构只编译标量实现
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define DIJKSTRA_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC/Clang 需为单个函数开启 AVX2 / SSE4.1 代码生成，MSVC 可直接使用内建函数
+#if defined(DIJKSTRA_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+#define DIJKSTRA_TARGET_AVX2 __attribute__((target("avx2")))
+#define DIJKSTRA_TARGET_SSE41 __attribute__((target("sse4.1")))
+#else
+#define DIJKSTRA_TARGET_AVX2
+#define DIJKSTRA_TARGET_SSE41
+#endif
+
+namespace SimdCpu {
+
+#ifdef DIJKSTRA_SIMD_X86
+inline bool hasAvx2()
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+        return false;
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    // 操作系统需保存 YMM 寄存器状态
+    if (!osxsave || !avx || (_xgetbv(0) & 6) != 6)
+        return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+inline bool hasSse41()
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 19)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.1");
+#endif
+}
+
+inline bool hasSse2()
+{
+#if defined(__x86_64__) || defined(_M_X64)
+    return true;
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[3] & (1 << 26)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse2");
+#endif
+}
+#else
+inline bool hasAvx2() { return false; }
+inline bool hasSse41() { return false; }
+inline bool hasSse2() { return false; }
+#endif // DIJKSTRA_SIMD_X86
+
+// 当前 CPU 可用的最快指令集，按包含关系排列（支持某一级即支持其前的各级）
+enum Level {
+    LevelScalar,
+    LevelSse2,
+    LevelSse41,
+    LevelAvx2
+};
+
+inline Level detect()
+{
+    static const Level level = hasAvx2() ? LevelAvx2
+                             : hasSse41() ? LevelSse41
+                             : hasSse2() ? LevelSse2 : LevelScalar;
+    return level;
+}
+
+inline const char *levelName(Level level)
+{
+    switch (level)
+    {
+    case LevelAvx2:
+        return "AVX2";
+    case LevelSse41:
+        return "SSE4.1";
+    case LevelSse2:
+        return "SSE2";
+    case LevelScalar:
+    default:
+        return "标量";
+    }
+}
+
+} // namespace SimdCpu
+
+#endif // DIJKSTRA_SIMD_H
@@ -0,0 +1,141 @@
+#include "dijkstra_treecache.h"
+#include <QMutexLocker>
+
+const qint64 ShortestPathTreeCache::DEFAULT_BUDGET = 64 * 1024 * 1024;
+
+ShortestPathTreeCache::ShortestPathTreeCache()
+    : m_useClock(0)
+    , m_memory(0)
+    , m_budget(DEFAULT_BUDGET)
+    , m_hits(0)
+    , m_misses(0)
+{
+}
+
+void ShortestPathTreeCache::setBudget(qint64 bytes)
+{
+    QMutexLocker locker(&m_mutex);
+    m_budget = qMax(bytes, qint64(0));
+    evictLocked(m_budget);
+}
+
+qint64 ShortestPathTreeCache::budget() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_budget;
+}
+
+QSharedPointer<const ShortestPathTree> ShortestPathTreeCache::find(int source, quint64 graphVersion, int target)
+{
+    QMutexLocker locker(&m_mutex);
+    auto it = m_entries.find(source);
+    if (it == m_entries.end())
+    {
+        m_misses.fetchAndAddRelaxed(1);
+        return QSharedPointer<const ShortestPathTree>();
+    }
+
+    // 图已修改：删除过期的树
+    if (it.value().tree->graphVersion != graphVersion)
+    {
+        m_memory -= it.value().tree->memoryUsage();
+        m_entries.erase(it);
+        m_misses.fetchAndAddRelaxed(1);
+        return QSharedPointer<const ShortestPathTree>();
+    }
+
+    const ShortestPathTree &tree = *it.value().tree;
+    bool usable = target == 0 ? tree.complete : tree.answers(target);
+    if (!usable)
+    {
+        m_misses.fetchAndAddRelaxed(1);
+        return QSharedPointer<const ShortestPathTree>();
+    }
+
+    it.value().lastUse = ++m_useClock;
+    m_hits.fetchAndAddRelaxed(1);
+    return it.value().tree;
+}
+
+bool ShortestPathTreeCache::containsComplete(int source, quint64 graphVersion) const
+{
+    QMutexLocker locker(&m_mutex);
+    auto it = m_entries.constFind(source);
+    return it != m_entries.constEnd() && it.value().tree->graphVersion == graphVersion
+        && it.value().tree->complete;
+}
+
+void ShortestPathTreeCache::insert(const QSharedPointer<const ShortestPathTree> &tree)
+{
+    if (!tree)
+        return;
+
+    QMutexLocker locker(&m_mutex);
+    auto it = m_entries.find(tree->source);
+    if (it != m_entries.end())
+    {
+        // 同一起点的搜索按距离顺序确定节点，确定得多的树包含确定得少的树
+        const ShortestPathTree &cached = *it.value().tree;
+        if (cached.graphVersion == tree->graphVersion
+            && (cached.complete || (!tree->complete && cached.settledCount >= tree->settledCount)))
+        {
+            it.value().lastUse = ++m_useClock;
+            return;
+        }
+        m_memory -= cached.memoryUsage();
+        m_entries.erase(it);
+    }
+
+    qint64 bytes = tree->memoryUsage();
+    if (bytes > m_budget)
+        return;
+
+    // 先腾出空间再插入，新树不会被自己挤掉
+    evictLocked(m_budget - bytes);
+    Entry entry;
+    entry.tree = tree;
+    entry.lastUse = ++m_useClock;
+    m_entries.insert(tree->source, entry);
+    m_memory += bytes;
+}
+
+void ShortestPathTreeCache::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_entries.clear();
+    m_memory = 0;
+}
+
+int ShortestPathTreeCache::size() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_entries.size();
+}
+
+qint64 ShortestPathTreeCache::memoryUsage() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_memory;
+}
+
+void ShortestPathTreeCache::resetCounters()
+{
+    m_hits.storeRelaxed(0);
+    m_misses.storeRelaxed(0);
+}
+
+void ShortestPathTreeCache::evictLocked(qint64 budget)
+{
+    // 条目数通常只有几十到几百，逐个比较使用序号即可
+    while (m_memory > budget && !m_entries.isEmpty())
+    {
+        auto oldest = m_entries.begin();
+        for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+        {
+            if (it.value().lastUse < oldest.value().lastUse)
+                oldest = it;
+        }
+        m_memory -= oldest.value().tree->memoryUsage();
+        m_entries.erase(oldest);
+    }
+}
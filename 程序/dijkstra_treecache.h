@@ -0,0 +1,113 @@
+#ifndef DIJKSTRA_TREECACHE_H
+#define DIJKSTRA_TREECACHE_H
+
+#include "dijkstra_csr.h"
+#include <QAtomicInteger>
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QVector>
+#include <QtGlobal>
+#include <algorithm>
+
+// 一个起点的最短路径树：已确定节点的距离和回溯用的前驱（索引 1..n）
+// 两种存放方式（确定的节点较多时稠密存放）：
+//   稠密   nodes 为空，distance/parent 按节点索引存放（大小 n + 1，未确定的节点距离为 CsrGraph::UNREACHABLE）
+//   稀疏   只存已确定的节点，nodes 升序，distance/parent 与之一一对应
+// 点对点搜索提前结束时通常只确定少数节点，稀疏存放使构建和内存都与确定的节点数成正比，与图的规模无关
+// 写入缓存后不再修改，可被多个线程同时读取
+struct ShortestPathTree
+{
+    int source = 0;
+    quint64 graphVersion = 0;       // 生成时的图版本
+    bool complete = false;          // 是否已遍历整个连通分量
+    int settledCount = 0;           // 已确定的节点数
+    QVector<int> nodes;             // 稀疏存放时的已确定节点（升序）；稠密存放时为空
+    QVector<long> distance;
+    QVector<int> parent;            // 起点和未确定节点为 0
+
+    // 节点在 distance/parent 中的位置，超出范围或（稀疏存放时）未确定为 -1
+    int slot(int node) const
+    {
+        if (nodes.isEmpty())
+            return node >= 0 && node < distance.size() ? node : -1;
+        auto it = std::lower_bound(nodes.constBegin(), nodes.constEnd(), node);
+        return it != nodes.constEnd() && *it == node ? int(it - nodes.constBegin()) : -1;
+    }
+    long distanceTo(int node) const
+    {
+        int k = slot(node);
+        return k < 0 ? long(CsrGraph::UNREACHABLE) : distance[k];
+    }
+    int parentOf(int node) const
+    {
+        int k = slot(node);
+        return k < 0 ? 0 : parent[k];
+    }
+
+    // 是否能回答到 target 的查询（完整的树对不可达节点也能给出结论）
+    bool answers(int target) const
+    {
+        return complete || distanceTo(target) < CsrGraph::UNREACHABLE;
+    }
+
+    qint64 memoryUsage() const
+    {
+        return qint64(nodes.size()) * qint64(sizeof(int)) + qint64(distance.size()) * qint64(sizeof(long))
+             + qint64(parent.size()) * qint64(sizeof(int));
+    }
+};
+
+// 按起点缓存最近使用的最短路径树（LRU），总内存不超过预算
+// 条目记录生成时的图版本，查找时版本不一致视为失效并删除；图修改时只需递增版本，不必遍历缓存
+// 查找和插入由互斥锁保护，返回的树是共享的只读数据，多个线程可同时查找和使用
+class ShortestPathTreeCache
+{
+public:
+    static const qint64 DEFAULT_BUDGET;     // 默认内存预算（字节）
+
+    ShortestPathTreeCache();
+
+    // 内存预算（字节），不大于 0 时不缓存；缩小预算立即淘汰超出的条目
+    void setBudget(qint64 bytes);
+    qint64 budget() const;
+
+    // 查找 source 的树：版本一致且能回答到 target 的查询（target 为 0 时要求完整）才算命中，否则返回空
+    QSharedPointer<const ShortestPathTree> find(int source, quint64 graphVersion, int target = 0);
+
+    // 是否已缓存 source 在该版本下的完整树（不计入命中统计，不改变使用顺序）
+    bool containsComplete(int source, quint64 graphVersion) const;
+
+    // 插入或替换 source 的树，按最近最少使用淘汰直到不超过预算；超过预算的单棵树不缓存
+    // 同一版本下已缓存的树完整或确定的节点不少于新树时保留原树
+    void insert(const QSharedPointer<const ShortestPathTree> &tree);
+
+    void clear();
+
+    int size() const;
+    qint64 memoryUsage() const;
+
+    // 命中与未命中次数（find 调用）
+    qint64 hitCount() const { return m_hits.loadRelaxed(); }
+    qint64 missCount() const { return m_misses.loadRelaxed(); }
+    void resetCounters();
+
+private:
+    struct Entry
+    {
+        QSharedPointer<const ShortestPathTree> tree;
+        quint64 lastUse = 0;        // 最近一次使用的序号，最小者最先淘汰
+    };
+
+    void evictLocked(qint64 budget);
+
+    mutable QMutex m_mutex;
+    QHash<int, Entry> m_entries;    // 起点索引 -> 树
+    quint64 m_useClock;             // 使用序号
+    qint64 m_memory;                // 已缓存树的总字节数
+    qint64 m_budget;
+    QAtomicInteger<qint64> m_hits;
+    QAtomicInteger<qint64> m_misses;
+};
+
+#endif // DIJKSTRA_TREECACHE_H
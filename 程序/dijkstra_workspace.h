@@ -0,0 +1,199 @@
+#ifndef DIJKSTRA_WORKSPACE_H
+#define DIJKSTRA_WORKSPACE_H
+
+#include "dijkstra_csr.h"
+#include "dijkstra_heap.h"
+#include <QList>
+#include <QVector>
+#include <QtGlobal>
+#include <limits>
+#include <type_traits>
+
+// 单源搜索的逐节点状态（暂定距离、是否已确定、前驱列表），按代号惰性复位
+// 每个条目记录最后写入时的代号，与当前代号不同即视为初始状态（距离无穷、未确定、无前驱）
+// reset() 只递增代号，搜索只写到达过的节点，只访问小片邻域的搜索开销与访问的节点数成正比
+class SearchWorkspace
+{
+public:
+    struct Entry
+    {
+        quint32 stamp = 0;          // 写入时的代号
+        bool visited = false;       // 是否已确定（出队）
+        long distance = CsrGraph::UNREACHABLE;
+        QList<int> parents;         // 最短路径上的前驱（可有多个）
+    };
+
+    // 为 n 个节点（索引 1..n）准备条目；节点数不变时不重新分配
+    // 节点增加时保留已有条目（新条目为初始状态），修复搜索树时可继续使用当前搜索的结果
+    void resize(int nodeCount)
+    {
+        if (m_entries.size() == nodeCount + 1)
+            return;
+        if (m_entries.size() > nodeCount + 1)
+            clear();
+        m_entries.resize(nodeCount + 1);
+    }
+
+    // 开始新的搜索：所有节点回到初始状态
+    void reset()
+    {
+        m_touched.resize(0);
+        if (++m_generation == 0)
+        {
+            // 代号回绕：清除旧代号，避免与很久以前的条目混淆
+            for (int v = 0; v < m_entries.size(); v++)
+                m_entries[v].stamp = 0;
+            m_generation = 1;
+        }
+    }
+
+    void clear()
+    {
+        m_entries.clear();
+        m_touched.clear();
+        m_generation = 1;
+    }
+
+    bool isTouched(int node) const { return m_entries[node].stamp == m_generation; }
+    bool visited(int node) const { return isTouched(node) && m_entries[node].visited; }
+    long distance(int node) const
+    {
+        return isTouched(node) ? m_entries[node].distance : CsrGraph::UNREACHABLE;
+    }
+    // 回溯路径使用的前驱，没有前驱（起点或未到达）时为 0
+    int firstParent(int node) const
+    {
+        const Entry &current = m_entries[node];
+        return current.stamp == m_generation && !current.parents.isEmpty() ? current.parents.first() : 0;
+    }
+
+    // 取得可写的条目，本次搜索第一次写入时先复位
+    Entry &entry(int node)
+    {
+        Entry &current = m_entries[node];
+        if (current.stamp != m_generation)
+        {
+            current.stamp = m_generation;
+            current.visited = false;
+            current.distance = CsrGraph::UNREACHABLE;
+            current.parents.clear();
+            m_touched.append(node);
+        }
+        return current;
+    }
+
+    // 本次搜索写过的节点
+    const QVector<int> &touchedNodes() const { return m_touched; }
+
+    // 一次写入全部节点（如并行 delta-stepping 的结果）：所有条目标记为本次搜索，
+    // 之后可经 rawEntries() 按节点并行写入，调用方负责写全每个条目的字段
+    void touchAll()
+    {
+        m_touched.resize(m_entries.size() - 1);
+        for (int v = 1; v < m_entries.size(); v++)
+        {
+            m_entries[v].stamp = m_generation;
+            m_touched[v - 1] = v;
+        }
+    }
+    Entry *rawEntries() { return m_entries.data(); }
+
+private:
+    QVector<Entry> m_entries;       // 按节点索引，0 不使用
+    QVector<int> m_touched;
+    quint32 m_generation = 1;       // 新条目的代号为 0，不属于任何一次搜索
+};
+
+// SearchWorkspace 的精简版：每个节点只有距离、是否已确定和（TrackPaths 时）一个回溯前驱，条目是定长的值
+// 不需要并列前驱列表的搜索（只读查询、只算距离）使用，复位方式与 SearchWorkspace 相同
+template <typename Weight, typename Index, bool TrackPaths>
+class CompactSearchWorkspace
+{
+    static_assert(std::numeric_limits<Weight>::max() >= CsrGraph::UNREACHABLE, "距离类型须能表示 CsrGraph::UNREACHABLE");
+
+    struct NoParent {};
+    struct WithParent
+    {
+        Index parent = 0;           // 回溯用的前驱，起点和未到达节点为 0
+    };
+
+public:
+    struct Entry : std::conditional<TrackPaths, WithParent, NoParent>::type
+    {
+        quint32 stamp = 0;
+        bool visited = false;
+        Weight distance = Weight(CsrGraph::UNREACHABLE);
+    };
+
+    void resize(int nodeCount)
+    {
+        if (m_entries.size() == nodeCount + 1)
+            return;
+        if (m_entries.size() > nodeCount + 1)
+            clear();
+        m_entries.resize(nodeCount + 1);
+    }
+
+    void reset()
+    {
+        if (++m_generation == 0)
+        {
+            for (int v = 0; v < m_entries.size(); v++)
+                m_entries[v].stamp = 0;
+            m_generation = 1;
+        }
+    }
+
+    void clear()
+    {
+        m_entries.clear();
+        m_generation = 1;
+    }
+
+    bool isTouched(Index node) const { return m_entries[node].stamp == m_generation; }
+    bool visited(Index node) const { return isTouched(node) && m_entries[node].visited; }
+    Weight distance(Index node) const
+    {
+        return isTouched(node) ? m_entries[node].distance : Weight(CsrGraph::UNREACHABLE);
+    }
+    Index firstParent(Index node) const
+    {
+        if constexpr (TrackPaths)
+            return isTouched(node) ? m_entries[node].parent : Index(0);
+        else
+            return Index(0);
+    }
+
+    Entry &entry(Index node)
+    {
+        Entry &current = m_entries[node];
+        if (current.stamp != m_generation)
+        {
+            current.stamp = m_generation;
+            current.visited = false;
+            current.distance = Weight(CsrGraph::UNREACHABLE);
+            if constexpr (TrackPaths)
+                current.parent = 0;
+        }
+        return current;
+    }
+
+private:
+    QVector<Entry> m_entries;
+    quint32 m_generation = 1;
+};
+
+// Dijkstra::query / queryDistance 的工作区：逐节点搜索状态和各类优先队列（按图选用其一）
+// 由调用方持有（每个线程一个），多个线程各用自己的工作区即可同时查询同一张图
+struct QueryWorkspace
+{
+    CompactSearchWorkspace<long, int, true> state;          // query：距离和回溯前驱
+    CompactSearchWorkspace<long, int, false> distanceState; // queryDistance：只有距离
+    QVector<int> settled;           // query 按确定顺序记录的节点（写入最短路径树缓存）
+    DaryHeap<4> daryHeap;
+    DialQueue dialQueue;
+    RadixHeap radixHeap;
+    FifoQueue fifoQueue;
+};
+
+#endif // DIJKSTRA_WORKSPACE_H
@@ -5,6 +5,8 @@
 #include <QSqlError>
 #include <QVariant>
 #include <QDir>
+#include <QFile>
+#include <QFileInfo>
 #include <QDebug>
 #include <QtGlobal>
 #include <QDateTime>
@@ -92,6 +94,14 @@ QString GraphDatabase::getPositionsTableName(const QString &tableName) const
     return QStringLiteral("positions_%1").arg(sanitizeTableName(tname));
 }
 
+QString GraphDatabase::allPairsFilePath(const QString &tableName) const
+{
+    QString tname = tableName.isEmpty() ? m_currentTable : sanitizeTableName(tableName);
+    if (tname.isEmpty())
+        return QString();
+    return QFileInfo(m_dbPath).absolutePath() + "/" + tname + ".apsp";
+}
+
 bool GraphDatabase::createMetaTables()
 {
     QSqlQuery query(m_db);
@@ -392,10 +402,17 @@ bool GraphDatabase::loadGraph(Dijkstra *graph, const QString &tableName)
         graph->setNodeLabel(id, label);
     }
 
+    // 数据载入完成，构建CSR；中心点标签缓存放在数据库文件旁，按表格区分
+    graph->freeze();
+    graph->setHubLabelFile(QFileInfo(m_dbPath).absolutePath() + "/" + tname + ".hub");
+    QString apspFile = allPairsFilePath(tname);
+    if (QFile::exists(apspFile))
+        graph->loadAllPairs(apspFile);
+
     return true;
 }
 
-bool GraphDatabase::saveGraph(Dijkstra *graph, const QString &tableName)
+bool GraphDatabase::saveGraph(const Dijkstra *graph, const QString &tableName)
 {
     if (!ensureOpen())
         return false;
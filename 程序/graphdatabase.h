@@ -40,8 +40,10 @@ public:
     QString currentTable() const { return m_currentTable; }
     
     // 图数据操作（操作当前表格）
+    // loadGraph 清空并填充 graph，调用方通常传入新建的实例，成功后再发布（见 GraphSnapshotStore）
+    // 界面经 DijkstraLoader::loadTable 在工作线程中用单独的连接调用，不阻塞界面
     bool loadGraph(Dijkstra *graph, const QString &tableName = QString());
-    bool saveGraph(Dijkstra *graph, const QString &tableName = QString());
+    bool saveGraph(const Dijkstra *graph, const QString &tableName = QString());
     bool addOrUpdateNode(long id, const QString &label, const QString &tableName = QString());
     bool addOrUpdateEdge(long id1, long id2, long distance, const QString &tableName = QString());
     bool clear(const QString &tableName = QString());
@@ -50,6 +52,9 @@ public:
     bool saveLayout(const QMap<long, QPointF> &positions, const QString &tableName = QString());
     bool loadLayout(QMap<long, QPointF> &positions, const QString &tableName = QString());
     
+    // 表格对应的全源距离矩阵文件（与数据库文件放在一起），loadGraph 时若存在且与图一致则自动载入
+    QString allPairsFilePath(const QString &tableName = QString()) const;
+
     QString databasePath() const { return m_dbPath; }
     QString lastError() const { return m_lastError; }
 
@@ -0,0 +1,153 @@
+#include "graphsnapshot.h"
+#include "dijkstra.h"
+#include <QMutexLocker>
+#include <QThread>
+#include <QThreadPool>
+
+namespace {
+
+// 旧图交给线程池释放：仍在使用它的后台查询各自持有引用，最后一个引用在哪个线程释放，旧图就在哪里析构
+void releaseGraph(QSharedPointer<Dijkstra> graph)
+{
+    if (graph)
+        QThreadPool::globalInstance()->start([old = std::move(graph)]() mutable { old.reset(); });
+}
+
+}
+
+GraphSnapshotStore::GraphSnapshotStore(QObject *parent)
+    : QObject(parent)
+    , m_current(new Dijkstra())
+    , m_readers(new QAtomicInt(0))
+    , m_writers(0)
+    , m_replaced(false)
+    , m_version(0)
+{
+}
+
+GraphSnapshotStore::~GraphSnapshotStore()
+{
+}
+
+QSharedPointer<const Dijkstra> GraphSnapshotStore::current() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_current;
+}
+
+QSharedPointer<const Dijkstra> GraphSnapshotStore::acquire()
+{
+    for (;;)
+    {
+        {
+            QMutexLocker locker(&m_mutex);
+            while (m_writers > 0)
+                m_writeFinished.wait(&m_mutex);
+
+            if (m_current->isFrozen() || m_current->nodeCount() == 0)
+            {
+                // 快照释放时读者数减一，图本身由删除器中的引用保持
+                QSharedPointer<Dijkstra> graph = m_current;
+                QSharedPointer<QAtomicInt> readers = m_readers;
+                readers->ref();
+                return QSharedPointer<const Dijkstra>(graph.get(), [graph, readers](const Dijkstra *) {
+                    readers->deref();
+                });
+            }
+        }
+
+        // 界面加边后图还未冻结（getDistance 时才冻结）：冻结会重排节点，交给界面线程进行
+        if (QThread::currentThread() == thread())
+        {
+            GraphWriter writer(this);
+            writer->freeze();
+        }
+        else
+        {
+            QMetaObject::invokeMethod(this, [this]() {
+                GraphWriter writer(this);
+                writer->freeze();
+            }, Qt::BlockingQueuedConnection);
+        }
+    }
+}
+
+QSharedPointer<Dijkstra> GraphSnapshotStore::createGraph() const
+{
+    QSharedPointer<Dijkstra> graph(new Dijkstra());
+    graph->copySettings(*current());
+    return graph;
+}
+
+void GraphSnapshotStore::publish(const QSharedPointer<Dijkstra> &graph)
+{
+    if (!graph || current() == graph)
+        return;
+
+    // 发布后的图只读，冻结和建表都在替换之前完成（载入线程已冻结时这里不再有工作）
+    graph->prepareQueries();
+
+    QSharedPointer<Dijkstra> previous;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_current == graph)
+            return;
+        previous = m_current;
+        m_current = graph;
+        m_readers.reset(new QAtomicInt(0));
+        m_version++;
+    }
+    emit graphPublished();
+    releaseGraph(std::move(previous));
+}
+
+quint64 GraphSnapshotStore::version() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_version;
+}
+
+Dijkstra *GraphSnapshotStore::beginWrite()
+{
+    QSharedPointer<Dijkstra> previous;
+    Dijkstra *graph;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_writers++ == 0)
+        {
+            m_replaced = false;
+            // 后台读者仍持有当前图：复制一份再写，读者继续使用原图
+            if (m_readers->loadAcquire() > 0)
+            {
+                QSharedPointer<Dijkstra> copy(new Dijkstra());
+                copy->copyGraph(*m_current);
+                previous = m_current;
+                m_current = copy;
+                m_readers.reset(new QAtomicInt(0));
+                m_replaced = true;
+            }
+        }
+        graph = m_current.get();
+    }
+    releaseGraph(std::move(previous));
+    return graph;
+}
+
+void GraphSnapshotStore::endWrite(bool changed)
+{
+    bool replaced;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (changed)
+            m_version++;
+        if (--m_writers > 0)
+            return;
+        replaced = m_replaced;
+        if (replaced)
+            m_version++;
+        m_writeFinished.wakeAll();
+    }
+    // 换成了副本：界面窗口改用新图
+    if (replaced)
+        emit graphPublished();
+}
@@ -0,0 +1,82 @@
+#ifndef GRAPHSNAPSHOT_H
+#define GRAPHSNAPSHOT_H
+
+#include <QObject>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QAtomicInt>
+#include <QSharedPointer>
+#include <QtGlobal>
+
+class Dijkstra;
+
+// 当前图的发布点，界面和后台查询共用
+// 载入文件或数据表时在 createGraph() 新建的 Dijkstra 实例中完成解析、冻结和索引，成功后 publish 一次替换共享指针（互斥锁只保护指针交换）；
+// 载入期间和失败时当前图不受影响，替换前已开始的查询继续在旧图上进行，旧图在最后一个持有者释放后销毁。
+// 界面线程是唯一的写入者：编辑和 getDistance 查询都在 GraphWriter 内直接修改当前图（与单线程时相同，不复制）。
+// 后台线程用 acquire() 取得只读快照并只调用 const 接口；写入开始时若仍有后台读者持有当前图，才复制一份（写时复制）再修改并替换
+class GraphSnapshotStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit GraphSnapshotStore(QObject *parent = nullptr);
+    ~GraphSnapshotStore();
+
+    // 界面线程读取当前图（节点、标签、边等）；界面线程自己的写入会直接反映在其中
+    QSharedPointer<const Dijkstra> current() const;
+
+    // 后台线程的只读快照：持有期间界面的写入改在副本上进行，不会修改该图；写入进行中时等待写入结束
+    QSharedPointer<const Dijkstra> acquire();
+
+    // 新建空图并继承当前图的查询设置（含节点重排方式），供载入文件或数据表使用
+    QSharedPointer<Dijkstra> createGraph() const;
+
+    // 发布新图：先在调用线程中冻结并建好只读查询用到的表（prepareQueries），再替换；发布后调用方不能再修改 graph
+    // 旧图由线程池释放，大图的析构不阻塞界面
+    void publish(const QSharedPointer<Dijkstra> &graph);
+
+    // 发布次数与修改图数据的写入次数之和，图数据变化时递增
+    quint64 version() const;
+
+signals:
+    void graphPublished();
+
+private:
+    friend class GraphWriter;
+
+    // 写入开始：没有后台读者时返回当前图本身，否则换成副本；可在同一线程嵌套
+    Dijkstra *beginWrite();
+    // 写入结束：changed 表示图数据有变化（递增版本）；换成副本时发出 graphPublished
+    void endWrite(bool changed);
+
+    mutable QMutex m_mutex;
+    mutable QWaitCondition m_writeFinished;
+    QSharedPointer<Dijkstra> m_current;
+    QSharedPointer<QAtomicInt> m_readers;  // 持有当前图的后台读者数，随当前图一起替换
+    int m_writers;                         // 进行中的写入层数（只在界面线程）
+    bool m_replaced;                       // 本次写入是否换成了副本
+    quint64 m_version;
+};
+
+// 界面线程对当前图的一次写入（修改图或调用 getDistance 等非 const 接口），析构时结束写入
+// 修改了节点、边或距离时调用 markChanged()；只改标签等不影响查询的数据时不必调用，也不会重新发布
+class GraphWriter
+{
+public:
+    explicit GraphWriter(GraphSnapshotStore *store) : m_store(store), m_graph(store->beginWrite()), m_changed(false) {}
+    ~GraphWriter() { m_store->endWrite(m_changed); }
+
+    Dijkstra *operator->() const { return m_graph; }
+    Dijkstra *graph() const { return m_graph; }
+    void markChanged() { m_changed = true; }
+
+private:
+    Q_DISABLE_COPY(GraphWriter)
+
+    GraphSnapshotStore *m_store;
+    Dijkstra *m_graph;
+    bool m_changed;
+};
+
+#endif // GRAPHSNAPSHOT_H
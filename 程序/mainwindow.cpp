@@ -4,6 +4,7 @@
 #include "databasemanagementwindow.h"
 #include "dijkstra_loader.h"
 #include "graphdatabase.h"
+#include "graphsnapshot.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QGridLayout>
@@ -25,11 +26,13 @@
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
-    , m_dijkstra(new Dijkstra())
+    , m_graphs(new GraphSnapshotStore(this))
+    , m_dijkstra(m_graphs->current())
     , m_visualizationWindow(nullptr)
     , m_dataManagementWindow(nullptr)
     , m_databaseManagementWindow(nullptr)
     , m_fileLoader(new DijkstraLoader(this))
+    , m_tableLoader(new DijkstraLoader(this))
     , m_graphDb(new GraphDatabase(this))
     , m_loadedFileName(QString())
 {
@@ -40,12 +43,15 @@ MainWindow::MainWindow(QWidget *parent)
     connect(m_fileLoader, &DijkstraLoader::progress, this, &MainWindow::onFileLoadProgress);
     connect(m_fileLoader, &DijkstraLoader::finished, this, &MainWindow::onFileLoadFinished);
     connect(m_fileLoader, &DijkstraLoader::lineProcessed, this, &MainWindow::onFileLoadLineProcessed);
+    connect(m_tableLoader, &DijkstraLoader::finished, this, &MainWindow::onTableLoadFinished);
+    connect(m_graphs, &GraphSnapshotStore::graphPublished, this, [this]() {
+        m_dijkstra = m_graphs->current();
+    });
     ensureDatabaseLoaded();
 }
 
 MainWindow::~MainWindow()
 {
-    delete m_dijkstra;
     if (m_visualizationWindow)
         delete m_visualizationWindow;
     if (m_dataManagementWindow)
@@ -188,9 +194,7 @@ void MainWindow::onLoadFile()
     if (fileName.isEmpty())
         return;
 
-    // 清空现有数据
-    m_dijkstra->clear();
-
+    // 在新图中加载，完成前当前图保持可用
     QFileInfo info(fileName);
     m_loadedFileName = info.fileName();
     m_labelFile->setText(QString("正在加载: %1").arg(m_loadedFileName));
@@ -200,7 +204,7 @@ void MainWindow::onLoadFile()
     
     // 设置忙碌光标并使用多线程加载
     QApplication::setOverrideCursor(Qt::BusyCursor);
-    m_fileLoader->loadFile(m_dijkstra, fileName);
+    m_fileLoader->loadFile(fileName, m_graphs->createGraph());
 }
 
 void MainWindow::onAddNode()
@@ -222,7 +226,20 @@ void MainWindow::onAddNode()
         return;
     }
 
-    if (m_dijkstra->addNodesDist(id1, id2, dist))
+    // 直接修改当前图，已有的边只修改距离
+    bool ok;
+    QString error;
+    {
+        GraphWriter graph(m_graphs);
+        bool edgeExists = graph->getNodeNeighbors(id1).contains(id2);
+        ok = edgeExists ? graph->setEdgeDistance(id1, id2, dist)
+                        : graph->addNodesDist(id1, id2, dist);
+        if (ok)
+            graph.markChanged();
+        else
+            error = graph->errorDescription();
+    }
+    if (ok)
     {
         m_editNode1->clear();
         m_editNode2->clear();
@@ -242,7 +259,7 @@ void MainWindow::onAddNode()
     }
     else
     {
-        QMessageBox::critical(this, "错误", QString("添加失败:\n%1").arg(m_dijkstra->errorDescription()));
+        QMessageBox::critical(this, "错误", QString("添加失败:\n%1").arg(error));
     }
 }
 
@@ -309,7 +326,15 @@ void MainWindow::onCalculatePath()
         };
     }
 
-    int result = m_dijkstra->getDistance(startId, endId, distance, path, animCallback);
+    // 按选定的查询引擎计算（界面线程独占写入，搜索状态留在图中供后续查询复用）
+    int result;
+    QString error;
+    {
+        GraphWriter graph(m_graphs);
+        result = graph->getDistance(startId, endId, distance, path, animCallback);
+        if (result == 0)
+            error = graph->errorDescription();
+    }
     
     // 如果可视化窗口打开，显示路径高亮（动画已在计算过程中显示）
     if (useVisualization && result > 0)
@@ -351,9 +376,9 @@ void MainWindow::onCalculatePath()
     }
     else
     {
-        m_textResult->setPlainText(QString("计算失败:\n%1").arg(m_dijkstra->errorDescription()));
+        m_textResult->setPlainText(QString("计算失败:\n%1").arg(error));
         m_labelStatus->setText("计算失败");
-        QMessageBox::critical(this, "错误", QString("计算失败:\n%1").arg(m_dijkstra->errorDescription()));
+        QMessageBox::critical(this, "错误", QString("计算失败:\n%1").arg(error));
     }
 }
 
@@ -388,7 +413,8 @@ void MainWindow::onClearData()
                                      QMessageBox::Yes | QMessageBox::No);
     if (ret == QMessageBox::Yes)
     {
-        m_dijkstra->clear();
+        // 发布空图（沿用当前设置），旧图由仍在使用它的查询持有到结束
+        m_graphs->publish(m_graphs->createGraph());
         m_textResult->clear();
         m_labelFile->setText("未加载文件");
         m_loadedFileName.clear();
@@ -412,7 +438,7 @@ void MainWindow::onOpenVisualization()
 {
     if (!m_visualizationWindow)
     {
-        m_visualizationWindow = new VisualizationWindow(m_dijkstra, m_graphDb, this);
+        m_visualizationWindow = new VisualizationWindow(m_graphs, m_graphDb, this);
         connect(m_visualizationWindow, &VisualizationWindow::graphDataChanged, this, [this]() {
             updateStatus();
             if (m_dataManagementWindow)
@@ -434,7 +460,7 @@ void MainWindow::onOpenDataManagement()
 {
     if (!m_dataManagementWindow)
     {
-        m_dataManagementWindow = new DataManagementWindow(m_dijkstra, m_graphDb, this);
+        m_dataManagementWindow = new DataManagementWindow(m_graphs, m_graphDb, this);
         m_dataManagementWindow->refreshData();
     }
     m_dataManagementWindow->show();
@@ -446,7 +472,7 @@ void MainWindow::onOpenDatabaseManagement()
 {
     if (!m_databaseManagementWindow)
     {
-        m_databaseManagementWindow = new DatabaseManagementWindow(m_graphDb, m_dijkstra, this);
+        m_databaseManagementWindow = new DatabaseManagementWindow(m_graphDb, m_graphs, this);
         connect(m_databaseManagementWindow, &DatabaseManagementWindow::tableSwitched, 
                 this, &MainWindow::onTableSwitched);
     }
@@ -479,6 +505,7 @@ void MainWindow::onFileLoadFinished(bool success, const QString &error)
     
     if (success)
     {
+        m_graphs->publish(m_fileLoader->takeLoadedGraph());
         m_labelStatus->setText("文件加载成功");
         updateStatus();
         
@@ -500,7 +527,7 @@ void MainWindow::onFileLoadFinished(bool success, const QString &error)
                 m_graphDb->setCurrentTable(tableName);
                 
                 // 保存数据到新表格
-                if (m_graphDb->saveGraph(m_dijkstra, tableName))
+                if (m_graphDb->saveGraph(m_dijkstra.data(), tableName))
                 {
                     m_labelStatus->setText(QString("文件加载成功，已保存到表格: %1").arg(displayName));
                     
@@ -518,7 +545,7 @@ void MainWindow::onFileLoadFinished(bool success, const QString &error)
                 // 如果创建失败（可能已存在），尝试使用现有表格
                 if (m_graphDb->setCurrentTable(tableName))
                 {
-                    if (m_graphDb->saveGraph(m_dijkstra, tableName))
+                    if (m_graphDb->saveGraph(m_dijkstra.data(), tableName))
                     {
                         m_labelStatus->setText(QString("文件加载成功，已更新表格: %1").arg(displayName));
                     }
@@ -584,13 +611,36 @@ void MainWindow::ensureDatabaseLoaded()
         return;
     }
 
-    if (m_graphDb->loadGraph(m_dijkstra) && m_dijkstra->nodeCount() > 0)
+    // 在工作线程中载入当前表格，完成后发布（见 onTableLoadFinished）
+    QString tableName = m_graphDb->currentTable();
+    if (tableName.isEmpty())
+        return;
+    m_labelStatus->setText("正在从数据库载入...");
+    m_tableLoader->loadTable(dbPath, tableName, m_graphs->createGraph());
+}
+
+void MainWindow::onTableLoadFinished(bool success, const QString &error)
+{
+    QSharedPointer<Dijkstra> graph = m_tableLoader->takeLoadedGraph();
+    if (!success || !graph || graph->nodeCount() == 0)
     {
-        m_loadedFileName = tr("数据库存档");
-        m_labelFile->setText(QString("已加载: %1").arg(m_loadedFileName));
-        m_labelStatus->setText(QString("已从数据库载入 %1 个节点").arg(m_dijkstra->nodeCount()));
+        if (!success)
+            qWarning() << "数据库载入失败:" << error;
         updateStatus();
+        return;
     }
+
+    m_graphs->publish(graph);
+    m_loadedFileName = tr("数据库存档");
+    m_labelFile->setText(QString("已加载: %1").arg(m_loadedFileName));
+    m_labelStatus->setText(QString("已从数据库载入 %1 个节点").arg(m_dijkstra->nodeCount()));
+    updateStatus();
+
+    // 载入期间可能已打开其他窗口
+    if (m_visualizationWindow)
+        m_visualizationWindow->updateGraph();
+    if (m_dataManagementWindow)
+        m_dataManagementWindow->refreshData();
 }
 
 void MainWindow::syncEdgeToDatabase(long id1, long id2, long distance)
@@ -3,6 +3,7 @@
 
 #include <QMainWindow>
 #include <QString>
+#include <QSharedPointer>
 #include "dijkstra.h"
 
 QT_BEGIN_NAMESPACE
@@ -19,6 +20,7 @@ class DataManagementWindow;
 class DatabaseManagementWindow;
 class DijkstraLoader;
 class GraphDatabase;
+class GraphSnapshotStore;
 
 class MainWindow : public QMainWindow
 {
@@ -41,6 +43,7 @@ private slots:
     void onFileLoadFinished(bool success, const QString &error);
     void onFileLoadLineProcessed(int lineCount);
     void onTableSwitched(const QString &tableName);
+    void onTableLoadFinished(bool success, const QString &error);
 
 private:
     void setupUI();
@@ -48,11 +51,13 @@ private:
     void ensureDatabaseLoaded();
     void syncEdgeToDatabase(long id1, long id2, long distance);
 
-    Dijkstra *m_dijkstra;
+    GraphSnapshotStore *m_graphs;   // 当前图的发布点，载入完成后替换
+    QSharedPointer<const Dijkstra> m_dijkstra;  // 当前图（随发布更新），修改和查询经 GraphWriter
     VisualizationWindow *m_visualizationWindow;
     DataManagementWindow *m_dataManagementWindow;
     DatabaseManagementWindow *m_databaseManagementWindow;
     DijkstraLoader *m_fileLoader;
+    DijkstraLoader *m_tableLoader;  // 启动时在工作线程中载入数据库存档
     GraphDatabase *m_graphDb;
 
     // UI组件
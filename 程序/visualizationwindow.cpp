@@ -1,6 +1,7 @@
 #include "visualizationwindow.h"
 #include "dijkstra.h"
 #include "graphdatabase.h"
+#include "graphsnapshot.h"
 #include <QVBoxLayout>
 #include <QDebug>
 #include <QHBoxLayout>
@@ -393,10 +394,12 @@ void GraphEdge::setPathEdge(bool isPath)
 
 // ==================== VisualizationWindow 实现 ====================
 
-VisualizationWindow::VisualizationWindow(Dijkstra *dijkstra, GraphDatabase *database, QWidget *parent)
+VisualizationWindow::VisualizationWindow(GraphSnapshotStore *graphs, GraphDatabase *database, QWidget *parent)
     : QMainWindow(parent)
-    , m_dijkstra(dijkstra)
+    , m_graphs(graphs)
+    , m_dijkstra(graphs->current())
     , m_database(database)
+    , m_distanceTableVersion(~quint64(0))
     , m_scene(nullptr)
     , m_view(nullptr)
     , m_animationTimer(nullptr)
@@ -412,6 +415,10 @@ VisualizationWindow::VisualizationWindow(Dijkstra *dijkstra, GraphDatabase *data
 {
     setupUI();
 
+    connect(graphs, &GraphSnapshotStore::graphPublished, this, [this]() {
+        m_dijkstra = m_graphs->current();
+    });
+
     // 从数据库加载已保存的布局（如果有）
     if (m_database)
     {
@@ -960,16 +967,20 @@ void VisualizationWindow::startAnimation(long startNode, long endNode)
     long distance = 0;
     QVector<long> path;
 
+    // 排队的动画步骤持有查询时的图：节点索引只对这张图有效，期间发布的新图不影响它们
+    GraphWriter writer(m_graphs);
+    QSharedPointer<const Dijkstra> graph = m_graphs->current();
+
     // 动画回调 - 实时更新节点状态
-    AnimationCallback animCallback = [this](int nodeIndex, long dist, bool finished) {
-        QMetaObject::invokeMethod(this, [this, nodeIndex, dist, finished]() {
+    AnimationCallback animCallback = [this, graph](int nodeIndex, long dist, bool finished) {
+        QMetaObject::invokeMethod(this, [this, graph, nodeIndex, dist, finished]() {
             if (finished)
             {
                 onAnimationFinished();
             }
             else
             {
-                long nodeID = m_dijkstra->nodeID(nodeIndex);
+                long nodeID = graph->nodeID(nodeIndex);
                 m_visitedNodes.insert(nodeID);
                 
                 // 更新节点显示状态
@@ -982,8 +993,8 @@ void VisualizationWindow::startAnimation(long startNode, long endNode)
                 }
                 
                 // 更新进度
-                int progress = m_dijkstra->nodeCount() > 0 ? 
-                              (m_visitedNodes.size() * 100 / m_dijkstra->nodeCount()) : 0;
+                int progress = graph->nodeCount() > 0 ? 
+                              (m_visitedNodes.size() * 100 / graph->nodeCount()) : 0;
                 m_animationProgress->setValue(qMin(progress, 95));
                 m_animationStatus->setText(QString("访问节点: %1 (距离: %2)").arg(nodeID).arg(dist));
                 
@@ -993,7 +1004,7 @@ void VisualizationWindow::startAnimation(long startNode, long endNode)
         }, Qt::QueuedConnection);
     };
 
-    int result = m_dijkstra->getDistance(startNode, endNode, distance, path, animCallback);
+    int result = writer->getDistance(startNode, endNode, distance, path, animCallback);
 
     if (result > 0)
     {
@@ -1061,7 +1072,16 @@ void VisualizationWindow::onQuickCalculate()
 
     QVector<long> path;
     long distance = 0;
-    int result = m_dijkstra->getDistance(startId, endId, distance, path);
+    int result;
+    QString error;
+    {
+        GraphWriter graph(m_graphs);
+        result = lookupDistanceTable(graph.graph(), startId, endId, distance, path);
+        if (result == 0)
+            result = graph->getDistance(startId, endId, distance, path);
+        if (result == 0)
+            error = graph->errorDescription();
+    }
     if (result > 0)
     {
         highlightPath(path);
@@ -1091,13 +1111,45 @@ void VisualizationWindow::onQuickCalculate()
     }
     else
     {
-        QString err = m_dijkstra->errorDescription();
-        if (err.isEmpty())
-            err = "计算失败";
-        QMessageBox::critical(this, "错误", err);
+        QMessageBox::critical(this, "错误", error.isEmpty() ? QString("计算失败") : error);
     }
 }
 
+int VisualizationWindow::lookupDistanceTable(Dijkstra *graph, long startId, long endId,
+                                             long &distance, QVector<long> &path)
+{
+    if (graph->nodeCount() == 0 || graph->nodeCount() > MAX_VISUALIZATION_NODES)
+        return 0;
+
+    // 冻结可能重排节点编号，先冻结再取索引
+    if (m_distanceTableVersion != m_graphs->version())
+    {
+        graph->freeze();
+        if (!m_distanceTable.build(graph->csrGraph()))
+            m_distanceTable.clear();
+        m_distanceTableVersion = m_graphs->version();
+    }
+    if (m_distanceTable.isEmpty() || m_distanceTable.nodeCount() != graph->nodeCount())
+        return 0;
+
+    int iStart = graph->nodeIndex(startId);
+    int iEnd = graph->nodeIndex(endId);
+    if (iStart == 0 || iEnd == 0 || iStart == iEnd)
+        return 0;
+
+    path.clear();
+    distance = m_distanceTable.distance(iStart, iEnd);
+    if (distance >= CsrGraph::UNREACHABLE)
+        return -1;
+
+    QVector<int> pathIndices;
+    if (!m_distanceTable.path(iStart, iEnd, pathIndices))
+        return 0;
+    for (int i = 0; i < pathIndices.size(); i++)
+        path.append(graph->nodeID(pathIndices[i]));
+    return path.size();
+}
+
 void VisualizationWindow::onQuickAddEdge()
 {
     bool ok1, ok2, ok3;
@@ -1116,19 +1168,35 @@ void VisualizationWindow::onQuickAddEdge()
         return;
     }
 
-    if (!m_dijkstra->addNodesDist(id1, id2, distance))
+    // 直接修改当前图，已有的边只修改距离
+    bool ok;
+    QString error;
     {
-        QMessageBox::critical(this, "错误", QString("添加失败:\n%1").arg(m_dijkstra->errorDescription()));
+        GraphWriter graph(m_graphs);
+        bool edgeExists = graph->getNodeNeighbors(id1).contains(id2);
+        ok = edgeExists ? graph->setEdgeDistance(id1, id2, distance)
+                        : graph->addNodesDist(id1, id2, distance);
+        if (ok)
+        {
+            graph.markChanged();
+            QString label1 = m_quickNode1LabelEdit->text().trimmed();
+            QString label2 = m_quickNode2LabelEdit->text().trimmed();
+            if (!label1.isEmpty())
+                graph->setNodeLabel(id1, label1);
+            if (!label2.isEmpty())
+                graph->setNodeLabel(id2, label2);
+        }
+        else
+        {
+            error = graph->errorDescription();
+        }
+    }
+    if (!ok)
+    {
+        QMessageBox::critical(this, "错误", QString("添加失败:\n%1").arg(error));
         return;
     }
 
-    QString label1 = m_quickNode1LabelEdit->text().trimmed();
-    QString label2 = m_quickNode2LabelEdit->text().trimmed();
-    if (!label1.isEmpty())
-        m_dijkstra->setNodeLabel(id1, label1);
-    if (!label2.isEmpty())
-        m_dijkstra->setNodeLabel(id2, label2);
-
     if (m_database)
     {
         m_database->addOrUpdateNode(id1, m_dijkstra->getNodeLabel(id1));
@@ -1161,7 +1229,8 @@ void VisualizationWindow::onNodeLabelChanged()
     QString label = m_editNodeLabel->text();
     if (label.isEmpty())
         label = QString::number(nodeID);
-    m_dijkstra->setNodeLabel(nodeID, label);
+    // 标签不影响查询，直接修改当前图，不重新发布
+    GraphWriter(m_graphs)->setNodeLabel(nodeID, label);
     if (m_database)
         m_database->addOrUpdateNode(nodeID, label);
 
@@ -1205,8 +1274,7 @@ void VisualizationWindow::updateStatistics()
     
     if (stats.nodeCount > 0)
     {
-        double density = (double)stats.edgeCount / (stats.nodeCount * (stats.nodeCount - 1) / 2.0);
-        statsText += QString("\n图密度: %1\n").arg(density, 0, 'f', 4);
+        statsText += QString("\n图密度: %1\n").arg(stats.density, 0, 'f', 4);
     }
 
     m_statsText->setPlainText(statsText);
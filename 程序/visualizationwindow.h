@@ -10,9 +10,12 @@
 #include <QMap>
 #include <QSet>
 #include <QPair>
+#include <QSharedPointer>
+#include "dijkstra_floyd.h"
 
 class Dijkstra;
 class GraphDatabase;
+class GraphSnapshotStore;
 class GraphView;
 class QLabel;
 class QTextEdit;
@@ -91,7 +94,7 @@ class VisualizationWindow : public QMainWindow
     Q_OBJECT
 
 public:
-    VisualizationWindow(Dijkstra *dijkstra, GraphDatabase *database, QWidget *parent = nullptr);
+    VisualizationWindow(GraphSnapshotStore *graphs, GraphDatabase *database, QWidget *parent = nullptr);
     ~VisualizationWindow();
     
     static const int MAX_VISUALIZATION_NODES = 500; // 最大可视化节点数
@@ -128,9 +131,14 @@ private:
     void updateStatistics();
     void autoLayout();
     QPointF calculateNodePosition(int index, int total);
+    int lookupDistanceTable(Dijkstra *graph, long startId, long endId, long &distance, QVector<long> &path);
     
-    Dijkstra *m_dijkstra;
+    GraphSnapshotStore *m_graphs;
+    QSharedPointer<const Dijkstra> m_dijkstra;  // 当前图，随 m_graphs 的发布更新
     GraphDatabase *m_database;
+    // 可视化规模的图通常被逐对点击查询：窗口自己保存 Floyd–Warshall 距离表，图数据变化后在下次快速计算时重算
+    FloydWarshall m_distanceTable;
+    quint64 m_distanceTableVersion;  // 距离表对应的 m_graphs 版本
     QGraphicsScene *m_scene;
     GraphView *m_view;
     